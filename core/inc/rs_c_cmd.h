@@ -46,11 +46,20 @@
 
 #define RS_C_SECURY_KEY_LEN   (32)
 
+// IF capability handshake version and capabilities
+#define RS_C_IF_CAPA_VER      (1)
+#define RS_C_IF_CAPA_RX_AGG   RS_BIT(0)
+#define RS_C_IF_CAPA_TX_AGG   RS_BIT(1)
+#define RS_C_IF_CAPA_TX_AMSDU RS_BIT(2)
+// MPDUs of BA sessions come unordered with sequence number, host reorders them
+#define RS_C_IF_CAPA_RX_REORDER RS_BIT(3)
+
 #define RS_C_IS_CMD(cmd)                                                                   \
 	(RS_C_IS_DATA_CMD(cmd) || RS_C_IS_COMMON_CMD(cmd) || RS_C_IS_FMAC_CTRL_CMD(cmd) || \
 	 RS_C_IS_FMAC_INDI_CMD(cmd) || RS_C_IS_DBG_CMD(cmd))
 
 #define RS_C_IS_DATA_RX(cmd)	   ((cmd) == RS_CMD_DATA_RX)
+#define RS_C_IS_DATA_RX_AGG(cmd)   ((cmd) == RS_CMD_DATA_RX_AGG)
 #define RS_C_IS_STATUS_RX(cmd)	   ((cmd) == RS_CMD_STATUS_RX)
 #define RS_C_IS_DATA_CMD(cmd)	   (((cmd) > RS_CMD_DATA_START) && ((cmd) < RS_CMD_DATA_MAX))
 #define RS_C_IS_COMMON_CMD(cmd)	   (((cmd) > RS_CMD_COMMON_START) && ((cmd) < RS_CMD_COMMON_MAX))
@@ -67,7 +76,9 @@ enum rs_data_cmd
 
 	RS_CMD_DATA_RX = 1,
 	RS_CMD_STATUS_RX = 2,
+	RS_CMD_DATA_RX_AGG = 3, // records of RX frames in one read, after IF capability handshake
 	RS_CMD_DATA_TX = 5,
+	RS_CMD_DATA_TX_AGG = 6, // records of TX frames in one write, after IF capability handshake
 
 	RS_CMD_DATA_MAX
 };
@@ -78,6 +89,7 @@ enum rs_common_cmd
 
 	RS_DEV_RESET_CMD = 11,
 	RS_DEV_GET_MAC_ADDR_CMD = 12,
+	RS_DEV_IF_CAPA_CMD = 13,
 
 	RS_CMD_COMMON_MAX
 };
@@ -371,6 +383,31 @@ struct rs_c_fw_ver_rsp {
 	u32 mac_feat;
 	u16 sta_max_count;
 	u8 vif_max_count;
+
+	// IF capability handshake, zero from firmware without it
+	u8 if_capa_ver;
+	u32 if_capa;
+};
+
+// Enable IF capabilities advertised in F/W version, response carries enabled ones
+struct rs_c_if_capa_req {
+	u32 capa;
+	u32 rx_agg_len; // max aggregated RX read
+	u32 tx_agg_len; // max aggregated TX write and its frames
+	u32 tx_agg_num;
+	u32 tx_amsdu_len; // max A-MSDU built by host and its subframes
+	u32 tx_amsdu_num;
+	u32 rx_reorder_win; // max BlockAck window host reorders, F/W caps ADDBA buffer size at it
+};
+
+// F/W limits of aggregated TX write, 0 takes host limit
+struct rs_c_if_capa_rsp {
+	u32 capa;
+	u32 rx_agg_len;
+	u32 tx_agg_len;
+	u32 tx_agg_num;
+	u32 tx_amsdu_len;
+	u32 tx_amsdu_num;
 };
 
 struct rs_c_mac_addr {
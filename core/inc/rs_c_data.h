@@ -32,6 +32,22 @@
 #define RS_C_RX_STATUS_EXT_LEN		      (sizeof(struct rs_c_rx_status_ext_hdr))
 #define RS_C_TX_EXT_LEN			      (sizeof(struct rs_c_tx_ext_hdr))
 
+// aggregated read or write carries whole IF frames as records, each starts aligned
+#define RS_C_AGG_ALIGN			      (4)
+#define RS_C_AGG_REC_SIZE(len) \
+	((((len) + RS_C_AGG_ALIGN - 1) / RS_C_AGG_ALIGN) * RS_C_AGG_ALIGN)
+
+// host limits of aggregated TX write, a bus write of it fits bus buffers
+#define RS_C_TX_AGG_LEN			      (2048)
+#define RS_C_TX_AGG_NUM_MAX		      (16)
+
+// sequence number of RX ext header
+#define RS_C_RX_SN(ext_hdr)		      ((((ext_hdr)->sn_hi) << 8) | ((ext_hdr)->sn_lo))
+
+// host limits of A-MSDU built of queued frames, a bus write of it fits bus buffers
+#define RS_C_TX_AMSDU_LEN		      (RS_C_TX_AGG_LEN - RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, 0))
+#define RS_C_TX_AMSDU_NUM_MAX		      (8)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -45,6 +61,13 @@ struct rs_c_data {
 	u8 data[RS_C_DATA_SIZE];
 };
 
+// common if header alone, aggregated write sends it ahead of its records
+struct rs_c_data_hdr {
+	u8 cmd;
+	u8 ext_len;
+	u16 data_len;
+};
+
 struct rs_c_ctrl_req {
 	u8 cmd;
 	u8 reserved;
@@ -140,12 +163,17 @@ struct rs_c_rx_ext_hdr {
 	u32 format_mod : 4;
 	u32 pre_type : 1;
 	u32 leg_rate : 4;
+	u32 sn_valid : 1; // given once RS_C_IF_CAPA_RX_REORDER is on
+	u32 sn_hi : 4;
 
 	union {
 		struct rs_c_rx_ext_ht ht;
 		struct rs_c_rx_ext_vht vht;
 		struct rs_c_rx_ext_he he;
 	};
+
+	// sequence number of MPDU, in spare bits so header size stays, see RS_C_RX_SN
+	u8 sn_lo;
 };
 
 // RX(FW -> HOST) Header
@@ -185,6 +213,17 @@ struct rs_c_rx_status {
 	struct rs_c_rx_status_ext_hdr ext_hdr;
 };
 
+// TX(FW <- HOST) Header, sent as separate fragment ahead of frame
+struct rs_c_tx_hdr {
+	// common if header
+	u8 cmd;
+	u8 ext_len; // extra information length (bytes, max 255 bytes)
+	u16 data_len;
+
+	// extra information
+	struct rs_c_tx_ext_hdr ext_hdr;
+};
+
 // TX(FW <- HOST) Header
 struct rs_c_tx_data {
 	// common if header
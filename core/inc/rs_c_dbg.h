@@ -12,6 +12,7 @@
 
 #include "rs_type.h"
 #include "rs_k_dbg.h"
+#include "rs_k_mem.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
@@ -52,6 +53,16 @@
 #define RS_FN_ENTRY_STR_ ">>> %s()"
 #define RS_FN_ENTRY_STR	 ">>> %s()\n", __func__
 
+// counters of rs_c_dbg_stat are per CPU, contexts counting at once do not share a cache line
+#define RS_C_DBG_STAT_ADD(field, val)                                  \
+	do {                                                           \
+		if (rs_c_dbg_stat) {                                   \
+			rs_k_percpu_add(&rs_c_dbg_stat->field, (val)); \
+		}                                                      \
+	} while (0)
+#define RS_C_DBG_STAT_INC(field) RS_C_DBG_STAT_ADD(field, 1)
+#define RS_C_DBG_STAT_SUM(field) ((rs_c_dbg_stat) ? rs_k_percpu_sum(&rs_c_dbg_stat->field) : 0)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -76,6 +87,13 @@ struct rs_c_dbg_stat_t {
 	struct {
 		u32 nb_recv;
 		u32 nb_err_len;
+		u32 nb_amsdu;
+		u32 nb_amsdu_sub;
+		// management frames, ones delivered by RX thread as their queue was full
+		u32 nb_mgmt;
+		u32 nb_mgmt_inline;
+		// data frames dropped as their queue was full
+		u32 nb_drop;
 	} rx;
 };
 
@@ -84,7 +102,8 @@ struct rs_c_dbg_stat_t {
 
 extern u32 rs_log_level;
 
-extern struct rs_c_dbg_stat_t rs_c_dbg_stat;
+// counters of every CPU, NULL without core
+extern struct rs_c_dbg_stat_t *rs_c_dbg_stat;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
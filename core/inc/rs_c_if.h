@@ -22,15 +22,61 @@
 #define RS_C_IF_WRITE_CMD    (0x0002)
 #define RS_C_IF_STATUS_CMD   (0x0010)
 
+// max fragments of one frame written at once
+#define RS_C_IF_FRAG_MAX     (24)
+
+// bus capability flags, segments of vectored I/O go to bus as they are without bounce copy
+#define RS_C_IF_BUS_READV    (1U << 0)
+#define RS_C_IF_BUS_WRITEV   (1U << 1)
+
+// bus handshake latency histogram, bucket i counts waits under 2^i us, last one longer ones too
+#define RS_C_IF_HS_HIST_NUM  (12)
+
+// bus read length granularity, read buffers are its multiple so rounded up reads fit
+#define RS_C_IF_READ_ALIGN   (512)
+#define RS_C_IF_READ_SIZE(len) ((((len) + RS_C_IF_READ_ALIGN - 1) / RS_C_IF_READ_ALIGN) * RS_C_IF_READ_ALIGN)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
 struct rs_c_if;
 typedef rs_ret(rs_c_callback_t)(struct rs_c_if *c_if);
 
+// contiguous piece of a frame, segment of vectored I/O
+struct rs_c_if_frag {
+	u8 *data;
+	u32 len;
+};
+
+// what vectored I/O of bus takes natively
+struct rs_c_if_bus_capa {
+	u32 flags;
+	// max segments of one call
+	u8 seg_max;
+	// segments but last one must be its multiple to go natively
+	u32 seg_align;
+};
+
+// handshake of bus between command and data phase of transaction
+struct rs_c_if_hs_stats {
+	u32 hist[RS_C_IF_HS_HIST_NUM];
+	// completed while spinning, after sleeping or not at all
+	u32 spin_cnt;
+	u32 sleep_cnt;
+	u32 timeout_cnt;
+	// spin budget of last wait
+	u32 spin_us;
+};
+
+// readv and writev may return RS_NOT_SUPPORT for segments they can not take natively,
+// generic path then goes through one flat buffer
 struct rs_c_if_ops {
 	rs_ret (*read)(struct rs_c_if *c_if, u32 addr, u8 *data, u32 len);
 	rs_ret (*write)(struct rs_c_if *c_if, u32 addr, u8 *data, u32 len);
+	rs_ret (*readv)(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num);
+	rs_ret (*writev)(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num);
+	rs_ret (*bus_capa)(struct rs_c_if *c_if, struct rs_c_if_bus_capa *capa);
+	rs_ret (*hs_stats)(struct rs_c_if *c_if, struct rs_c_if_hs_stats *stats);
 	rs_ret (*read_status)(struct rs_c_if *c_if, u8 *data, u32 len);
 	rs_ret (*reload)(struct rs_c_if *c_if);
 };
@@ -76,6 +122,18 @@ rs_ret rs_c_if_read(struct rs_c_if *c_if, u32 addr, u8 *buf, u32 len);
 // Write to I/F
 rs_ret rs_c_if_write(struct rs_c_if *c_if, u32 addr, u8 *buf, u32 len);
 
+// Read one frame from I/F into segments, buffers must be DMA capable
+rs_ret rs_c_if_readv(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num);
+
+// Write segments of one frame to I/F, buffers must be DMA capable
+rs_ret rs_c_if_writev(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num);
+
+// Get vectored I/O capability of I/F bus
+rs_ret rs_c_if_get_bus_capa(struct rs_c_if *c_if, struct rs_c_if_bus_capa *capa);
+
+// Get handshake statistics of I/F bus, RS_NOT_SUPPORT if bus has no handshake
+rs_ret rs_c_if_get_hs_stats(struct rs_c_if *c_if, struct rs_c_if_hs_stats *stats);
+
 // Read Status from I/F
 rs_ret rs_c_if_read_status(struct rs_c_if *c_if, u8 *buf, u32 len);
 
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+#ifndef RS_C_POOL_H
+#define RS_C_POOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+// Buffer allocator of pool, rs_k_malloc and rs_k_free are used without it
+struct rs_c_pool_ops {
+	u8 *(*alloc)(u32 size);
+	void (*free)(u8 *buf);
+};
+
+// Recycled buffers of one size
+// Free buffers form a stack linked through their first bytes, pushed and popped by compare and swap.
+// Buffers are put back from any context, but only one context gets them: a buffer cannot be
+// popped and pushed again between the read and the swap of a pop, so the stack has no ABA.
+struct rs_c_pool {
+	void *top;
+	u32 free_count;
+
+	// read only after init
+	u32 buf_size;
+	u32 buf_num;
+	u32 low_mark;
+	u32 max_num;
+	const struct rs_c_pool_ops *ops;
+
+	// owned, refilled ones included, detached ones excluded
+	u32 own_num;
+	u32 detach_cnt;
+
+	// getter only
+	u32 get_cnt;
+	u32 min_free;
+	// buffers added below low mark and when pool ran empty
+	u32 refill_cnt;
+	u32 exhaust_cnt;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Initialize pool of buf_num buffers, refilled below low_mark up to max_num buffers
+rs_ret rs_c_pool_init(struct rs_c_pool *pool, u32 buf_size, u32 buf_num, u32 low_mark, u32 max_num,
+		      const struct rs_c_pool_ops *ops);
+
+// Free all buffers, every buffer must have been put back
+rs_ret rs_c_pool_deinit(struct rs_c_pool *pool);
+
+// Get buffer, not zeroed (single getter)
+void *rs_c_pool_get(struct rs_c_pool *pool);
+
+// Put buffer back (any context)
+void rs_c_pool_put(struct rs_c_pool *pool, void *buf);
+
+// Hand buffer over for good, its new owner frees it (single detacher)
+void rs_c_pool_detach(struct rs_c_pool *pool, void *buf);
+
+#endif /* RS_C_POOL_H */
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+#ifndef RS_C_RING_H
+#define RS_C_RING_H
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+#define RS_C_RING_CACHE_LINE_SIZE (64)
+
+// Slot index of n-th entry from first index returned by bulk functions
+#define RS_C_RING_IDX(ring, first_idx, n) (((first_idx) + (n)) & (ring)->mask)
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+// Single producer / single consumer ring status
+// head is written by producer only, tail is written by consumer only.
+// Each side keeps a cached copy of the other index on its own cache line.
+struct rs_c_ring {
+	// producer
+	u32 head __aligned(RS_C_RING_CACHE_LINE_SIZE);
+	u32 tail_cache;
+
+	// consumer
+	u32 tail __aligned(RS_C_RING_CACHE_LINE_SIZE);
+	u32 head_cache;
+
+	// read only after init
+	u32 mask __aligned(RS_C_RING_CACHE_LINE_SIZE);
+	u32 max_count;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Initialize ring, max_count must be power of two
+rs_ret rs_c_ring_init(struct rs_c_ring *ring, u32 max_count);
+
+// Get free slot index (producer)
+s32 rs_c_ring_prod_idx(struct rs_c_ring *ring);
+
+// Publish filled slot (producer)
+void rs_c_ring_prod_commit(struct rs_c_ring *ring);
+
+// Get used slot index (consumer)
+s32 rs_c_ring_cons_idx(struct rs_c_ring *ring);
+
+// Release consumed slot (consumer)
+void rs_c_ring_cons_commit(struct rs_c_ring *ring);
+
+// Get up to max_count free slots, first slot index in first_idx (producer)
+u32 rs_c_ring_prod_n(struct rs_c_ring *ring, u32 max_count, u32 *first_idx);
+
+// Publish count filled slots (producer)
+void rs_c_ring_prod_commit_n(struct rs_c_ring *ring, u32 count);
+
+// Get up to max_count used slots, first slot index in first_idx (consumer)
+u32 rs_c_ring_cons_n(struct rs_c_ring *ring, u32 max_count, u32 *first_idx);
+
+// Release count consumed slots (consumer)
+void rs_c_ring_cons_commit_n(struct rs_c_ring *ring, u32 count);
+
+// Get used count
+u32 rs_c_ring_count(struct rs_c_ring *ring);
+
+// Check ring empty
+rs_ret rs_c_ring_empty(struct rs_c_ring *ring);
+
+// Check ring full
+rs_ret rs_c_ring_full(struct rs_c_ring *ring);
+
+#endif /* RS_C_RING_H */
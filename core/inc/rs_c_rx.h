@@ -11,12 +11,24 @@
 /// INCLUDE
 
 #include "rs_type.h"
+#include "rs_c_data.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
 #define RS_C_RX_EVENT (1)
 
+#ifdef CONFIG_RS_NAPI
+// RX data queues, each polled by its own NAPI of net
+#define RS_C_RX_DATA_Q_MAX (8)
+#else
+// RX DATA thread or work is the only consumer
+#define RS_C_RX_DATA_Q_MAX (1)
+#endif
+
+// RX read buffer, largest frame rounded up to bus read granularity
+#define RS_C_RX_BUF_SIZE RS_C_IF_READ_SIZE(sizeof(struct rs_c_rx_data))
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -38,4 +50,20 @@ rs_ret rs_c_rx_data_init(struct rs_c_if *c_if, u16 rx_buf_num);
 // Deinitialize RX Data handler
 rs_ret rs_c_rx_data_deinit(struct rs_c_if *c_if);
 
+#ifdef CONFIG_RS_NAPI
+// Spread data frames over q_num queues, set before NAPIs of net poll them
+rs_ret rs_c_rx_data_set_q_num(struct rs_c_if *c_if, u8 q_num);
+
+// Queue of data frame, frames of one station TID share one
+u8 rs_c_rx_data_q_idx(struct rs_c_if *c_if, struct rs_c_rx_ext_hdr *ext_hdr);
+
+// Deliver up to budget RX data queued in q_idx, returns delivered count
+u32 rs_c_rx_data_poll(struct rs_c_if *c_if, u8 q_idx, u32 budget);
+#endif
+
+#ifdef CONFIG_RS_SELFTEST
+// Feed aggregated reads through mock I/F, RS_SUCCESS when records split as expected
+rs_ret rs_c_rx_agg_selftest(struct rs_c_if *c_if);
+#endif
+
 #endif /* RS_C_RX_H */
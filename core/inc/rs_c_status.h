@@ -42,6 +42,21 @@ void rs_c_set_status_bits(struct rs_c_if *c_if, u8 status_bits);
 // set status
 void rs_c_set_status(struct rs_c_if *c_if, u32 status);
 
+// Sample TX written count before RX thread reads a frame which may carry status
+void rs_c_status_rx_mark(struct rs_c_if *c_if);
+
+// Count a frame written to bus, TX thread only
+void rs_c_status_tx_written(struct rs_c_if *c_if, u8 ac);
+
+// TX credit, reported avail count less frames written since it was read
+s32 rs_c_status_tx_credit(struct rs_c_if *c_if, u8 ac);
+
+// No TX credit left, read status from bus, rate limited while stalled
+s32 rs_c_status_tx_credit_refill(struct rs_c_if *c_if, u8 ac);
+
+// TX of ac waits for credit reported by firmware
+bool rs_c_status_tx_stalled(struct rs_c_if *c_if, u8 ac);
+
 // rx status : 1 == empty
 u8 rs_c_get_status_rx(struct rs_c_if *c_if);
 
@@ -11,6 +11,7 @@
 /// INCLUDE
 
 #include "rs_type.h"
+#include "rs_c_if.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
@@ -19,6 +20,11 @@
 #define RS_C_TX_AC_EVENT    (0x01)
 #define RS_C_TX_POWER_EVENT (0x02)
 
+// CoDel state buckets, data frames are hashed by flow
+#define RS_C_TX_CODEL_FLOW_MAX	 (64)
+// log2 microsecond buckets of sojourn time, last one collects the rest
+#define RS_C_TX_SOJOURN_HIST_MAX (20)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -30,6 +36,17 @@ enum rs_c_tx_data_ac
 	RS_IF_DATA_MAX,
 };
 
+// WMM access category lanes of IF_DATA_AC, in dequeue priority order
+enum rs_c_tx_lane
+{
+	RS_C_TX_LANE_VO = 0,
+	RS_C_TX_LANE_VI = 1,
+	RS_C_TX_LANE_BE = 2,
+	RS_C_TX_LANE_BK = 3,
+
+	RS_C_TX_LANE_MAX,
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL VARIABLE
 
@@ -37,11 +54,38 @@ enum rs_c_tx_data_ac
 /// GLOBAL FUNCTION
 
 // Initialize TX handler
-rs_ret rs_c_tx_init(struct rs_c_if *c_if, u16 tx_buf_num, u16 tx_buf_power_num);
+rs_ret rs_c_tx_init(struct rs_c_if *c_if, u16 sta_num, u16 txq_depth, u16 tx_buf_power_num);
 
 // Deinitialize TX handler
 rs_ret rs_c_tx_deinit(struct rs_c_if *c_if);
 
+// Get TX data queue of station, tid
+struct rs_c_txq *rs_c_tx_get_txq(struct rs_c_if *c_if, u8 sta_idx, u8 tid);
+
+// Get queued data frame count of lane
+u32 rs_c_tx_lane_count(struct rs_c_if *c_if, u8 lane);
+
+// Get sojourn time percentile of data frames in microseconds, upper bound of histogram bucket
+u32 rs_c_tx_sojourn_pct(struct rs_c_if *c_if, u8 pct);
+
+// Push data frame, with more the TX thread kick is deferred until the last frame of burst
+rs_ret rs_c_tx_data_post(struct rs_c_if *c_if, s8 vif_idx, u8 *tx_skb, bool more);
+
+// Kick TX thread for deferred data frames
+rs_ret rs_c_tx_kick(struct rs_c_if *c_if);
+
+// Hold TX while firmware is off channel for up to window_us, 0 when back on channel
+rs_ret rs_c_tx_set_off_channel(struct rs_c_if *c_if, u32 window_us);
+
+// Aggregate up to agg_num frames in writes of up to agg_len bytes, agg_num 0 sends frames one by one
+rs_ret rs_c_tx_set_agg(struct rs_c_if *c_if, u32 agg_len, u32 agg_num);
+
+// Build A-MSDUs of up to amsdu_num frames and amsdu_len bytes, amsdu_num 0 sends frames one by one
+rs_ret rs_c_tx_set_amsdu(struct rs_c_if *c_if, u32 amsdu_len, u32 amsdu_num);
+
+// Limit A-MSDUs to station to amsdu_len bytes, 0 sends its frames one by one
+rs_ret rs_c_tx_set_sta_amsdu(struct rs_c_if *c_if, u8 sta_idx, u16 amsdu_len);
+
 // Post TX event
 rs_ret rs_c_tx_event_post(struct rs_c_if *c_if, u8 ac, s8 vif_idx, u8 *tx_skb);
 
@@ -16,16 +16,23 @@
 #include "rs_k_mutex.h"
 #include "rs_k_spin_lock.h"
 #include "rs_k_thread.h"
+#include "rs_k_timer.h"
 #include "rs_c_q.h"
+#include "rs_c_ring.h"
+#include "rs_c_pool.h"
 #include "rs_c_if.h"
 #include "rs_c_data.h"
 #include "rs_c_indi.h"
+#include "rs_c_tx.h"
+#include "rs_c_rx.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
 #define RS_CORE_STATUS_SIZE (4)
 
+#define RS_C_TX_TID_MAX	    (8)
+
 #define C_RX_THREAD
 #define C_TX_THREAD
 #define C_REC_THREAD
@@ -36,6 +43,43 @@
 struct rs_c_q_buf {
 	s8 vif_idx;
 	u8 *data;
+
+	// TX data only, enqueue time and flow hash for AQM
+	u32 enq_us;
+	u32 flow_hash;
+};
+
+// RX data queue, RX thread is its only producer
+struct rs_c_rx_data_q {
+	struct rs_c_ring buf_q;
+	struct rs_c_rx_data **buf;
+};
+
+// CoDel state of hashed flow
+struct rs_c_codel {
+	u32 first_above_us;
+	u32 drop_next_us;
+	u32 count;
+	u32 last_count;
+	bool dropping;
+};
+
+// TX data queue per (sta_idx, tid)
+struct rs_c_txq {
+	struct rs_c_ring ring;
+	struct rs_c_q_buf *buf;
+
+	// DRR deficit in bytes
+	s32 deficit;
+
+	// vifs whose netdev queue was stopped on this queue full
+	u32 stop_vif_mask;
+
+	// A-MSDU length limit of station, 0 when off
+	u16 amsdu_len;
+
+	u8 sta_idx;
+	u8 tid;
 };
 
 struct rs_core {
@@ -50,6 +94,20 @@ struct rs_core {
 	struct {
 		u8 *value;
 		struct rs_k_mutex mutex;
+
+		// TX credit per data ac, firmware reported avail count in bits 31..24, TX written
+		// count in bits 23..0 sampled before the report was read from bus
+		u32 credit_sync[RS_IF_DATA_MAX];
+		// written to bus, TX thread only
+		u32 tx_written[RS_IF_DATA_MAX];
+		// sampled before RX thread bus read
+		u32 rx_mark[RS_IF_DATA_MAX];
+		// TX thread found no credit after bus read
+		u32 credit_stall[RS_IF_DATA_MAX];
+		u32 credit_read[RS_IF_DATA_MAX];
+		u32 stall_us[RS_IF_DATA_MAX];
+		// bit per ac, set by TX thread and cleared by credit report of RX thread
+		unsigned long stall_flags;
 	} status;
 
 	struct {
@@ -66,9 +124,7 @@ struct rs_core {
 #else
 		struct rs_k_work work;
 #endif
-		struct rs_k_spin_lock lock;
-
-		struct rs_q buf_q;
+		struct rs_c_ring buf_q;
 		struct rs_c_indi **buf;
 		u16 buf_num;
 	} indi;
@@ -80,20 +136,36 @@ struct rs_core {
 #else
 		struct rs_k_work work;
 #endif
+
+		// IF capabilities enabled by handshake, RS_C_IF_CAPA_X
+		u32 if_capa;
+		// aggregated reads, records split out of them and malformed ones, RX thread only
+		u32 agg_cnt;
+		u32 agg_rec_cnt;
+		u32 agg_err_cnt;
 	} rx;
 
+	// buffers of bus reads, back from RX data and indication consumers
+	struct rs_c_pool rx_pool;
+
 	struct {
-#ifdef C_RX_THREAD
+#if defined(CONFIG_RS_NAPI)
+		// consumer is NAPI poll of net
+#elif defined(C_RX_THREAD)
 		struct rs_k_event *event;
 		struct rs_k_thread thread;
 #else
 		struct rs_k_work work;
 #endif
-		struct rs_k_spin_lock spin_lock;
-
-		struct rs_q buf_q;
-		struct rs_c_rx_data **buf;
+		// frames of one station TID go to one queue, q_num of them are in use
+		struct rs_c_rx_data_q q[RS_C_RX_DATA_Q_MAX];
+		u8 q_num;
 		u16 buf_num;
+#ifndef CONFIG_RS_NAPI
+		// management frames, drained ahead of data by same consumer
+		struct rs_c_ring mgmt_q;
+		struct rs_c_rx_data **mgmt_buf;
+#endif
 	} rx_data;
 
 	struct {
@@ -105,15 +177,69 @@ struct rs_core {
 		struct rs_k_work work;
 #endif
 
+		// serialize producers, consumer is TX thread only
 		struct rs_k_spin_lock spin_lock;
 
-		struct rs_q buf_q;
-		struct rs_c_q_buf *buf;
-		u16 buf_num;
+		// data, [sta_idx * RS_C_TX_TID_MAX + tid]
+		struct rs_c_txq *txq;
+		u16 txq_num;
+		u16 txq_depth;
 
-		struct rs_q buf_power_q;
+		// next lane member for DRR
+		u16 lane_rr[RS_C_TX_LANE_MAX];
+		// count of services given to higher lanes since lane was last served
+		u16 lane_skip[RS_C_TX_LANE_MAX];
+		u32 lane_sent[RS_C_TX_LANE_MAX];
+		u32 lane_starve[RS_C_TX_LANE_MAX];
+
+		// AQM, TX thread only
+		struct rs_c_codel codel[RS_C_TX_CODEL_FLOW_MAX];
+		u32 codel_drop;
+		u32 codel_mark;
+		u32 lifetime_drop;
+		u32 sojourn_hist[RS_C_TX_SOJOURN_HIST_MAX];
+
+		struct rs_c_ring buf_power_q;
 		struct rs_c_q_buf *buf_power;
 		u16 buf_power_num;
+
+		// kick of xmit_more burst deferred, safety timer posts it if last frame never comes
+		struct rs_k_timer kick_timer;
+		unsigned long kick_flags;
+		u32 kick_cnt;
+		u32 kick_defer_cnt;
+		u32 kick_timer_cnt;
+
+		// firmware is off the operating channel, TX is held until it returns or window ends
+		bool off_chan;
+		u32 off_chan_until_us;
+		u32 off_chan_cnt;
+		u32 off_chan_expire_cnt;
+
+		// fragments of frame being written, TX thread only
+		struct rs_c_if_frag frag[RS_C_IF_FRAG_MAX];
+		u32 sg_cnt;
+
+		// aggregated write after IF capability handshake, agg_num 0 when off
+		u32 agg_len;
+		u8 agg_num;
+		// frames held for aggregated write in frag, frag[0] is its header, TX thread only
+		struct rs_c_data_hdr agg_hdr;
+		struct rs_c_q_buf agg_buf[RS_C_TX_AGG_NUM_MAX];
+		u8 agg_cnt;
+		u8 agg_ac;
+		u8 agg_frag_num;
+		u32 agg_write_cnt;
+		u32 agg_frame_cnt;
+
+		// A-MSDU after IF capability handshake, amsdu_num 0 when off
+		u16 amsdu_len;
+		u8 amsdu_num;
+		// A-MSDU being built of frames of one queue, TX thread only
+		struct rs_c_q_buf amsdu_buf;
+		u8 amsdu_cnt;
+		// sent frames of A-MSDU queues by subframe count - 1
+		u32 amsdu_hist[RS_C_TX_AMSDU_NUM_MAX];
 	} tx_data;
 
 	struct {
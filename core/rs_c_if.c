@@ -27,6 +27,74 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+static u32 c_if_frag_len(struct rs_c_if_frag *frag, u8 frag_num)
+{
+	u32 len = 0;
+	u8 i = 0;
+
+	for (i = 0; i < frag_num; i++) {
+		len += frag[i].len;
+	}
+
+	return len;
+}
+
+// Generic readv, frame is read flat and scattered over segments
+static rs_ret c_if_readv_flat(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+	u8 *buf = NULL;
+	u32 pos = 0;
+	u8 i = 0;
+
+	if (frag_num == 1) {
+		ret = c_if->if_ops.read(c_if, addr, frag[0].data, frag[0].len);
+	} else {
+		buf = rs_k_calloc(c_if_frag_len(frag, frag_num));
+		if (buf) {
+			ret = c_if->if_ops.read(c_if, addr, buf, c_if_frag_len(frag, frag_num));
+			if (ret >= RS_SUCCESS) {
+				for (i = 0; i < frag_num; i++) {
+					(void)rs_k_memcpy(frag[i].data, buf + pos, frag[i].len);
+					pos += frag[i].len;
+				}
+			}
+			rs_k_free(buf);
+		} else {
+			ret = RS_MEMORY_FAIL;
+		}
+	}
+
+	return ret;
+}
+
+// Generic writev, segments are gathered and frame is written flat
+static rs_ret c_if_writev_flat(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+	u8 *buf = NULL;
+	u32 pos = 0;
+	u8 i = 0;
+
+	if (frag_num == 1) {
+		ret = c_if->if_ops.write(c_if, addr, frag[0].data, frag[0].len);
+	} else {
+		buf = rs_k_calloc(c_if_frag_len(frag, frag_num));
+		if (buf) {
+			for (i = 0; i < frag_num; i++) {
+				(void)rs_k_memcpy(buf + pos, frag[i].data, frag[i].len);
+				pos += frag[i].len;
+			}
+			ret = c_if->if_ops.write(c_if, addr, buf, pos);
+			rs_k_free(buf);
+		} else {
+			ret = RS_MEMORY_FAIL;
+		}
+	}
+
+	return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
@@ -70,6 +138,71 @@ rs_ret rs_c_if_write(struct rs_c_if *c_if, u32 addr, u8 *buf, u32 len)
 	return ret;
 }
 
+rs_ret rs_c_if_readv(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_NOT_SUPPORT;
+
+	if (c_if && frag && frag_num > 0 && c_if->core->recovery.in_recovery == FALSE) {
+		if (c_if->if_ops.readv) {
+			ret = c_if->if_ops.readv(c_if, addr, frag, frag_num);
+		}
+		if ((ret == RS_NOT_SUPPORT) && c_if->if_ops.read) {
+			ret = c_if_readv_flat(c_if, addr, frag, frag_num);
+		}
+	}
+
+	return (ret == RS_NOT_SUPPORT) ? RS_FAIL : ret;
+}
+
+rs_ret rs_c_if_writev(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_NOT_SUPPORT;
+
+	if (c_if && frag && frag_num > 0 && c_if->core->recovery.in_recovery == FALSE) {
+		if (c_if->if_ops.writev) {
+			ret = c_if->if_ops.writev(c_if, addr, frag, frag_num);
+		}
+		if ((ret == RS_NOT_SUPPORT) && c_if->if_ops.write) {
+			ret = c_if_writev_flat(c_if, addr, frag, frag_num);
+		}
+	}
+
+	return (ret == RS_NOT_SUPPORT) ? RS_FAIL : ret;
+}
+
+rs_ret rs_c_if_get_bus_capa(struct rs_c_if *c_if, struct rs_c_if_bus_capa *capa)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && capa) {
+		// generic path takes any segments through one flat buffer
+		capa->flags = 0;
+		capa->seg_max = RS_C_IF_FRAG_MAX;
+		capa->seg_align = 1;
+		ret = RS_SUCCESS;
+
+		if (c_if->if_ops.bus_capa) {
+			ret = c_if->if_ops.bus_capa(c_if, capa);
+		}
+	}
+
+	return ret;
+}
+
+rs_ret rs_c_if_get_hs_stats(struct rs_c_if *c_if, struct rs_c_if_hs_stats *stats)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && stats) {
+		ret = RS_NOT_SUPPORT;
+		if (c_if->if_ops.hs_stats) {
+			ret = c_if->if_ops.hs_stats(c_if, stats);
+		}
+	}
+
+	return ret;
+}
+
 rs_ret rs_c_if_read_status(struct rs_c_if *c_if, u8 *buf, u32 len)
 {
 	rs_ret ret = RS_FAIL;
@@ -22,14 +22,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
-#define C_INDI_SPIN_INIT(c_if)	 (void)rs_k_spin_lock_create(&c_if->core->indi.lock)
-#define C_INDI_SPIN_DEINIT(c_if) (void)rs_k_spin_lock_destroy(&c_if->core->indi.lock)
-#define C_INDI_SPIN_LOCK(c_if)	 (void)rs_k_spin_lock(&c_if->core->indi.lock)
-#define C_INDI_SPIN_UNLOCK(c_if) (void)rs_k_spin_unlock(&c_if->core->indi.lock)
-
 #define C_IF_INDI_ADDR		 (0)
 #define C_INDI_THREAD_NAME	 "RSW_INDI_THREAD"
 
+#define C_INDI_BATCH		 (8)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -39,29 +36,27 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+// RX thread is the only producer, INDI thread is the only consumer
 static rs_ret c_indi_push(struct rs_c_if *c_if, struct rs_c_indi *indi_data)
 {
 	rs_ret ret = RS_FAIL;
 	s32 free_idx = RS_FAIL;
 
 	if (c_if && c_if->core && indi_data) {
-		C_INDI_SPIN_LOCK(c_if);
-
-		free_idx = rs_c_q_push(&c_if->core->indi.buf_q);
+		free_idx = rs_c_ring_prod_idx(&c_if->core->indi.buf_q);
 
-		if (free_idx != RS_FULL) {
+		if (free_idx >= 0) {
 			if (!c_if->core->indi.buf[free_idx]) {
 				c_if->core->indi.buf[free_idx] = indi_data;
+				rs_c_ring_prod_commit(&c_if->core->indi.buf_q);
 			} else {
-				RS_ERR("indi q push err : uidx[%d]:ucnt[%d]:fidx[%d]\n",
-				       c_if->core->indi.buf_q.used_idx, c_if->core->indi.buf_q.used_count,
-				       c_if->core->indi.buf_q.free_idx);
+				RS_ERR("indi q push err : head[%u]:tail[%u]:fidx[%d]\n",
+				       c_if->core->indi.buf_q.head, c_if->core->indi.buf_q.tail, free_idx);
+				free_idx = RS_FAIL;
 			}
 		} else {
 			RS_ERR("indi full[%d]\n", free_idx);
 		}
-
-		C_INDI_SPIN_UNLOCK(c_if);
 	}
 
 	if (free_idx >= 0) {
@@ -73,48 +68,62 @@ static rs_ret c_indi_push(struct rs_c_if *c_if, struct rs_c_indi *indi_data)
 	return ret;
 }
 
-static rs_ret c_indi_pop(struct rs_c_if *c_if, struct rs_c_indi **indi_data)
+// Pop up to max_count indications at once, returns popped count
+static u32 c_indi_pop_n(struct rs_c_if *c_if, struct rs_c_indi **indi_data, u32 max_count)
 {
-	rs_ret ret = RS_FAIL;
-	s32 used_idx = RS_FAIL;
+	u32 count = 0;
+	u32 first_idx = 0;
+	u32 used_idx = 0;
+	u32 i = 0;
 
 	if (c_if && c_if->core && indi_data) {
-		C_INDI_SPIN_LOCK(c_if);
+		count = rs_c_ring_cons_n(&c_if->core->indi.buf_q, max_count, &first_idx);
 
-		used_idx = rs_c_q_pop(&c_if->core->indi.buf_q);
+		for (i = 0; i < count; i++) {
+			used_idx = RS_C_RING_IDX(&c_if->core->indi.buf_q, first_idx, i);
 
-		if (used_idx != RS_EMPTY) {
-			if (c_if->core->indi.buf[used_idx]) {
-				*indi_data = c_if->core->indi.buf[used_idx];
-				c_if->core->indi.buf[used_idx] = NULL;
-			} else {
-				RS_ERR("indi q pop err : uidx[%d]:ucnt[%d]:fidx[%d]\n",
-				       c_if->core->indi.buf_q.used_idx, c_if->core->indi.buf_q.used_count,
-				       c_if->core->indi.buf_q.free_idx);
+			indi_data[i] = c_if->core->indi.buf[used_idx];
+			c_if->core->indi.buf[used_idx] = NULL;
+			if (!indi_data[i]) {
+				RS_ERR("indi q pop err : head[%u]:tail[%u]:uidx[%u]\n",
+				       c_if->core->indi.buf_q.head, c_if->core->indi.buf_q.tail, used_idx);
 			}
 		}
 
-		C_INDI_SPIN_UNLOCK(c_if);
+		rs_c_ring_cons_commit_n(&c_if->core->indi.buf_q, count);
 	}
 
-	if (used_idx >= 0) {
-		ret = RS_SUCCESS;
-	} else {
-		ret = used_idx;
-	}
+	return count;
+}
 
-	return ret;
+// Handle popped indications and free them
+static void c_indi_handle_n(struct rs_c_if *c_if, struct rs_c_indi **indi_data, u32 count)
+{
+	u32 i = 0;
+
+	for (i = 0; i < count; i++) {
+		if (indi_data[i]) {
+			(void)rs_net_rx_indi(c_if, indi_data[i]);
+
+			rs_c_pool_put(&c_if->core->rx_pool, indi_data[i]);
+			indi_data[i] = NULL;
+		}
+	}
 }
 
 static rs_ret c_indi_q_free(struct rs_c_if *c_if)
 {
-	rs_ret ret = RS_FAIL;
-	struct rs_c_indi *temp_indi_data = NULL;
-
-	while ((ret = c_indi_pop(c_if, &temp_indi_data)) >= RS_SUCCESS) {
-		if (temp_indi_data) {
-			rs_k_free(temp_indi_data);
-			temp_indi_data = NULL;
+	rs_ret ret = RS_SUCCESS;
+	struct rs_c_indi *temp_indi_data[C_INDI_BATCH] = { NULL };
+	u32 count = 0;
+	u32 i = 0;
+
+	while ((count = c_indi_pop_n(c_if, temp_indi_data, C_INDI_BATCH)) > 0) {
+		for (i = 0; i < count; i++) {
+			if (temp_indi_data[i]) {
+				rs_c_pool_put(&c_if->core->rx_pool, temp_indi_data[i]);
+				temp_indi_data[i] = NULL;
+			}
 		}
 	}
 
@@ -126,19 +135,16 @@ static s32 c_indi_thread(void *param)
 {
 	struct rs_c_if *c_if = param;
 	rs_k_event_t ret_event = 0;
-	struct rs_c_indi *temp_indi_data = NULL;
+	struct rs_c_indi *temp_indi_data[C_INDI_BATCH] = { NULL };
+	u32 count = 0;
 
 	if (c_if && c_if->core) {
 		do {
 			ret_event = rs_k_event_wait(c_if->core->indi.event, RS_C_INDI_EVENT);
 
 			if (ret_event == RS_C_INDI_EVENT) {
-				while (c_indi_pop(c_if, &temp_indi_data) == RS_SUCCESS) {
-					(void)rs_net_rx_indi(c_if, temp_indi_data);
-					if (temp_indi_data) {
-						rs_k_free(temp_indi_data);
-						temp_indi_data = NULL;
-					}
+				while ((count = c_indi_pop_n(c_if, temp_indi_data, C_INDI_BATCH)) > 0) {
+					c_indi_handle_n(c_if, temp_indi_data, count);
 				}
 			}
 
@@ -162,16 +168,12 @@ static s32 c_indi_thread(void *param)
 static void c_indi_work_handler(void *param)
 {
 	struct rs_c_if *c_if = param;
-	struct rs_c_indi *temp_indi_data = NULL;
+	struct rs_c_indi *temp_indi_data[C_INDI_BATCH] = { NULL };
+	u32 count = 0;
 
 	if (c_if && c_if->core) {
-		while (c_indi_pop(c_if, &temp_indi_data) == RS_SUCCESS) {
-			(void)rs_net_rx_indi(c_if, temp_indi_data);
-
-			if (temp_indi_data) {
-				rs_k_free(temp_indi_data);
-				temp_indi_data = NULL;
-			}
+		while ((count = c_indi_pop_n(c_if, temp_indi_data, C_INDI_BATCH)) > 0) {
+			c_indi_handle_n(c_if, temp_indi_data, count);
 		}
 	}
 }
@@ -189,13 +191,11 @@ rs_ret rs_c_indi_init(struct rs_c_if *c_if, u16 indi_buf_num)
 	RS_TRACE(RS_FN_ENTRY_STR);
 
 	if (c_if && c_if->core && indi_buf_num > 0) {
-		C_INDI_SPIN_INIT(c_if);
-
 		c_if->core->indi.buf =
-			(struct rs_c_indi **)rs_k_calloc(indi_buf_num * sizeof(struct rs_c_indi));
+			(struct rs_c_indi **)rs_k_calloc(indi_buf_num * sizeof(struct rs_c_indi *));
 		if (c_if->core->indi.buf) {
 			c_if->core->indi.buf_num = indi_buf_num;
-			ret = rs_c_q_init(&c_if->core->indi.buf_q, indi_buf_num);
+			ret = rs_c_ring_init(&c_if->core->indi.buf_q, indi_buf_num);
 
 #ifdef C_RX_THREAD
 			c_if->core->indi.event = rs_k_calloc(sizeof(struct rs_k_event));
@@ -244,8 +244,6 @@ rs_ret rs_c_indi_deinit(struct rs_c_if *c_if)
 			c_if->core->indi.buf = NULL;
 			c_if->core->indi.buf_num = 0;
 		}
-
-		C_INDI_SPIN_DEINIT(c_if);
 	}
 
 	return ret;
@@ -265,7 +263,7 @@ rs_ret rs_c_indi_event_post(struct rs_c_if *c_if, struct rs_c_indi *indi_data)
 
 			ret = c_indi_push(c_if, (struct rs_c_indi *)indi_data);
 		}
-		if (rs_c_q_empty(&c_if->core->indi.buf_q) != RS_EMPTY) {
+		if (rs_c_ring_empty(&c_if->core->indi.buf_q) != RS_EMPTY) {
 #ifdef C_RX_THREAD
 			(void)rs_k_event_post(c_if->core->indi.event, RS_C_INDI_EVENT);
 #else
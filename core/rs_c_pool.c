@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+#include "rs_k_atomic.h"
+#include "rs_k_mem.h"
+#include "rs_c_dbg.h"
+
+#include "rs_c_pool.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+// free buffer keeps link to next one in its first bytes
+#define C_POOL_NEXT(buf) (*(void **)(buf))
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+static void *c_pool_alloc(struct rs_c_pool *pool)
+{
+	void *buf = NULL;
+
+	if (pool->ops && pool->ops->alloc) {
+		buf = pool->ops->alloc(pool->buf_size);
+	} else {
+		buf = rs_k_malloc(pool->buf_size);
+	}
+
+	return buf;
+}
+
+static void c_pool_free(struct rs_c_pool *pool, void *buf)
+{
+	if (pool->ops && pool->ops->free) {
+		pool->ops->free(buf);
+	} else {
+		rs_k_free(buf);
+	}
+}
+
+static void c_pool_push(struct rs_c_pool *pool, void *buf)
+{
+	void *top = NULL;
+
+	// counted first, free_count never falls below buffers in stack
+	(void)rs_k_atomic_add_return(&pool->free_count, 1);
+
+	do {
+		top = rs_k_atomic_load_ptr(&pool->top);
+		C_POOL_NEXT(buf) = top;
+	} while (rs_k_atomic_cmpxchg_ptr(&pool->top, top, buf) != top);
+}
+
+static void *c_pool_pop(struct rs_c_pool *pool)
+{
+	void *top = NULL;
+
+	do {
+		top = rs_k_atomic_load_ptr(&pool->top);
+		if (!top) {
+			break;
+		}
+		// top stays in stack until this swap, nobody else pops
+	} while (rs_k_atomic_cmpxchg_ptr(&pool->top, top, C_POOL_NEXT(top)) != top);
+
+	return top;
+}
+
+// Bring free buffers back to low mark, owned buffers stay within max_num
+static void c_pool_refill(struct rs_c_pool *pool, u32 free_count)
+{
+	void *buf = NULL;
+
+	while ((free_count < pool->low_mark) && (pool->own_num < pool->max_num)) {
+		buf = c_pool_alloc(pool);
+		if (!buf) {
+			break;
+		}
+
+		(void)rs_k_atomic_add_return(&pool->own_num, 1);
+		pool->refill_cnt++;
+		c_pool_push(pool, buf);
+		free_count++;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+rs_ret rs_c_pool_init(struct rs_c_pool *pool, u32 buf_size, u32 buf_num, u32 low_mark, u32 max_num,
+		      const struct rs_c_pool_ops *ops)
+{
+	rs_ret ret = RS_FAIL;
+	void *buf = NULL;
+	u32 i = 0;
+
+	if (pool && (buf_size >= sizeof(void *)) && (buf_num > 0) && (low_mark <= buf_num) &&
+	    (max_num >= buf_num)) {
+		(void)rs_k_memset(pool, 0, sizeof(struct rs_c_pool));
+		pool->buf_size = buf_size;
+		pool->buf_num = buf_num;
+		pool->low_mark = low_mark;
+		pool->max_num = max_num;
+		pool->ops = ops;
+
+		ret = RS_SUCCESS;
+		for (i = 0; i < buf_num; i++) {
+			buf = c_pool_alloc(pool);
+			if (!buf) {
+				ret = RS_MEMORY_FAIL;
+				break;
+			}
+
+			pool->own_num++;
+			c_pool_push(pool, buf);
+		}
+		pool->min_free = pool->free_count;
+
+		if (ret != RS_SUCCESS) {
+			(void)rs_c_pool_deinit(pool);
+		}
+	} else {
+		ret = RS_INVALID_PARAM;
+	}
+
+	return ret;
+}
+
+rs_ret rs_c_pool_deinit(struct rs_c_pool *pool)
+{
+	rs_ret ret = RS_FAIL;
+	void *buf = NULL;
+	u32 freed = 0;
+
+	if (pool) {
+		while ((buf = c_pool_pop(pool)) != NULL) {
+			c_pool_free(pool, buf);
+			freed++;
+		}
+
+		if (freed != pool->own_num) {
+			RS_ERR("pool buf not put back[%u][%u]\n", pool->own_num, freed);
+		}
+
+		pool->own_num = 0;
+		pool->free_count = 0;
+
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+void *rs_c_pool_get(struct rs_c_pool *pool)
+{
+	void *buf = NULL;
+	u32 free_count = 0;
+
+	if (pool) {
+		buf = c_pool_pop(pool);
+		if (buf) {
+			pool->get_cnt++;
+
+			free_count = rs_k_atomic_add_return(&pool->free_count, -1);
+			if (free_count < pool->min_free) {
+				pool->min_free = free_count;
+			}
+			if (free_count < pool->low_mark) {
+				c_pool_refill(pool, free_count);
+			}
+		} else {
+			// every buffer is out, pool grows by this one
+			pool->exhaust_cnt++;
+
+			buf = c_pool_alloc(pool);
+			if (buf) {
+				pool->get_cnt++;
+				(void)rs_k_atomic_add_return(&pool->own_num, 1);
+			}
+		}
+	}
+
+	return buf;
+}
+
+void rs_c_pool_put(struct rs_c_pool *pool, void *buf)
+{
+	if (pool && buf) {
+		c_pool_push(pool, buf);
+	}
+}
+
+void rs_c_pool_detach(struct rs_c_pool *pool, void *buf)
+{
+	if (pool && buf) {
+		// getter may refill at the same time
+		(void)rs_k_atomic_add_return(&pool->own_num, -1);
+		pool->detach_cnt++;
+	}
+}
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+#include "rs_k_atomic.h"
+
+#include "rs_c_ring.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+#define C_RING_MAX_COUNT (0x40000000)
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Initialize ring, max_count must be power of two
+rs_ret rs_c_ring_init(struct rs_c_ring *ring, u32 max_count)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (ring && (max_count > 0) && (max_count <= C_RING_MAX_COUNT) &&
+	    ((max_count & (max_count - 1)) == 0)) {
+		ring->head = 0;
+		ring->tail_cache = 0;
+		ring->tail = 0;
+		ring->head_cache = 0;
+		ring->mask = max_count - 1;
+		ring->max_count = max_count;
+
+		ret = RS_SUCCESS;
+	} else {
+		ret = RS_INVALID_PARAM;
+	}
+
+	return ret;
+}
+
+// Get free slot index (producer)
+s32 rs_c_ring_prod_idx(struct rs_c_ring *ring)
+{
+	s32 free_idx = RS_FAIL;
+
+	if (ring && ring->max_count > 0) {
+		if ((ring->head - ring->tail_cache) >= ring->max_count) {
+			// pairs with release in rs_c_ring_cons_commit()
+			ring->tail_cache = rs_k_atomic_load_acquire(&ring->tail);
+		}
+
+		if ((ring->head - ring->tail_cache) >= ring->max_count) {
+			free_idx = RS_FULL;
+		} else {
+			free_idx = (s32)(ring->head & ring->mask);
+		}
+	}
+
+	return free_idx;
+}
+
+// Publish filled slot (producer)
+void rs_c_ring_prod_commit(struct rs_c_ring *ring)
+{
+	if (ring) {
+		rs_k_atomic_store_release(&ring->head, ring->head + 1);
+	}
+}
+
+// Get used slot index (consumer)
+s32 rs_c_ring_cons_idx(struct rs_c_ring *ring)
+{
+	s32 used_idx = RS_FAIL;
+
+	if (ring && ring->max_count > 0) {
+		if (ring->head_cache == ring->tail) {
+			// pairs with release in rs_c_ring_prod_commit()
+			ring->head_cache = rs_k_atomic_load_acquire(&ring->head);
+		}
+
+		if (ring->head_cache == ring->tail) {
+			used_idx = RS_EMPTY;
+		} else {
+			used_idx = (s32)(ring->tail & ring->mask);
+		}
+	}
+
+	return used_idx;
+}
+
+// Release consumed slot (consumer)
+void rs_c_ring_cons_commit(struct rs_c_ring *ring)
+{
+	if (ring) {
+		rs_k_atomic_store_release(&ring->tail, ring->tail + 1);
+	}
+}
+
+// Get up to max_count free slots, first slot index in first_idx (producer)
+u32 rs_c_ring_prod_n(struct rs_c_ring *ring, u32 max_count, u32 *first_idx)
+{
+	u32 count = 0;
+
+	if (ring && ring->max_count > 0 && first_idx) {
+		count = ring->max_count - (ring->head - ring->tail_cache);
+		if (count < max_count) {
+			ring->tail_cache = rs_k_atomic_load_acquire(&ring->tail);
+			count = ring->max_count - (ring->head - ring->tail_cache);
+		}
+
+		if (count > max_count) {
+			count = max_count;
+		}
+
+		*first_idx = ring->head & ring->mask;
+	}
+
+	return count;
+}
+
+// Publish count filled slots (producer)
+void rs_c_ring_prod_commit_n(struct rs_c_ring *ring, u32 count)
+{
+	if (ring && count > 0) {
+		rs_k_atomic_store_release(&ring->head, ring->head + count);
+	}
+}
+
+// Get up to max_count used slots, first slot index in first_idx (consumer)
+u32 rs_c_ring_cons_n(struct rs_c_ring *ring, u32 max_count, u32 *first_idx)
+{
+	u32 count = 0;
+
+	if (ring && ring->max_count > 0 && first_idx) {
+		count = ring->head_cache - ring->tail;
+		if (count < max_count) {
+			ring->head_cache = rs_k_atomic_load_acquire(&ring->head);
+			count = ring->head_cache - ring->tail;
+		}
+
+		if (count > max_count) {
+			count = max_count;
+		}
+
+		*first_idx = ring->tail & ring->mask;
+	}
+
+	return count;
+}
+
+// Release count consumed slots (consumer)
+void rs_c_ring_cons_commit_n(struct rs_c_ring *ring, u32 count)
+{
+	if (ring && count > 0) {
+		rs_k_atomic_store_release(&ring->tail, ring->tail + count);
+	}
+}
+
+// Get used count
+u32 rs_c_ring_count(struct rs_c_ring *ring)
+{
+	u32 count = 0;
+	u32 tail = 0;
+
+	if (ring) {
+		// tail first, head never passes behind it
+		tail = rs_k_atomic_load_acquire(&ring->tail);
+		count = rs_k_atomic_load_acquire(&ring->head) - tail;
+		if (count > ring->max_count) {
+			count = ring->max_count;
+		}
+	}
+
+	return count;
+}
+
+// Check ring empty
+rs_ret rs_c_ring_empty(struct rs_c_ring *ring)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (ring) {
+		if (rs_c_ring_count(ring) == 0) {
+			ret = RS_EMPTY;
+		} else {
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
+// Check ring full
+rs_ret rs_c_ring_full(struct rs_c_ring *ring)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (ring) {
+		if (rs_c_ring_count(ring) >= ring->max_count) {
+			ret = RS_FULL;
+		} else {
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
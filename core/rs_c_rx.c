@@ -34,18 +34,56 @@
 
 #define RS_C_RX_DATA_EVENT		 (1)
 
+#define C_RX_DATA_BATCH			 (16)
+
+#ifndef CONFIG_RS_NAPI
+// management frames waiting for RX DATA consumer, power of two
+#define C_RX_MGMT_BUF_NUM		 (32)
+#endif
+
+// golden ratio multiplier, consecutive station and TID keys land in different queues
+#define C_RX_DATA_Q_HASH		 (0x9E3779B1U)
+
+#ifdef CONFIG_RS_SELFTEST
+// aggregated reads fed by mock bus, records carry a TX command so dispatch drops them
+#define C_RX_SELFTEST_MULTI		 (0)
+#define C_RX_SELFTEST_TRUNC		 (1)
+#define C_RX_SELFTEST_OVERSIZE		 (2)
+#define C_RX_SELFTEST_NESTED		 (3)
+#define C_RX_SELFTEST_NUM		 (4)
+#define C_RX_SELFTEST_REC_CMD		 RS_CMD_DATA_TX
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
-#define C_RX_DATA_SPIN_LOCK_INIT(c_if)	 (void)rs_k_spin_lock_create(&c_if->core->rx_data.spin_lock)
-#define C_RX_DATA_SPIN_LOCK_DEINIT(c_if) (void)rs_k_spin_lock_destroy(&c_if->core->rx_data.spin_lock)
-#define C_RX_DATA_SPIN_LOCK(c_if)	 (void)rs_k_spin_lock(&c_if->core->rx_data.spin_lock)
-#define C_RX_DATA_SPIN_TRYLOCK(c_if)	 rs_k_spin_trylock(&c_if->core->rx_data.spin_lock)
-#define C_RX_DATA_SPIN_UNLOCK(c_if)	 (void)rs_k_spin_unlock(&c_if->core->rx_data.spin_lock)
+#ifdef CONFIG_RS_SELFTEST
+// bus of mock I/F, one read returns image
+struct c_rx_mock_bus {
+	u8 *image;
+	u32 len;
+};
+
+// expected outcome of one aggregated read
+struct c_rx_selftest_expect {
+	rs_ret ret;
+	u32 rec_cnt;
+	u32 err_cnt;
+};
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
 
+#ifdef CONFIG_RS_SELFTEST
+static const struct c_rx_selftest_expect c_rx_selftest_expect[C_RX_SELFTEST_NUM] = {
+	[C_RX_SELFTEST_MULTI] = { RS_SUCCESS, 3, 0 },
+	[C_RX_SELFTEST_TRUNC] = { RS_FAIL, 1, 1 },
+	[C_RX_SELFTEST_OVERSIZE] = { RS_FAIL, 0, 1 },
+	[C_RX_SELFTEST_NESTED] = { RS_FAIL, 1, 1 },
+};
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
@@ -64,32 +102,25 @@ static rs_ret c_rx_status_set(struct rs_c_if *c_if, struct rs_c_rx_status *rx_st
 
 // RX DATA
 
-static rs_ret c_rx_data_push(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data)
+// RX thread is the only producer, RX DATA thread is the only consumer of each queue
+static rs_ret c_rx_data_push(struct rs_c_ring *buf_q, struct rs_c_rx_data **buf, struct rs_c_rx_data *rx_data)
 {
 	rs_ret ret = RS_FAIL;
 	s32 free_idx = RS_FAIL;
 
-	if (c_if && c_if->core && rx_data) {
-		C_RX_DATA_SPIN_LOCK(c_if);
-
-		free_idx = rs_c_q_push(&c_if->core->rx_data.buf_q);
+	if (buf_q && buf && rx_data) {
+		free_idx = rs_c_ring_prod_idx(buf_q);
 
-		if (free_idx != RS_FULL) {
-			if (!c_if->core->rx_data.buf[free_idx]) {
-				c_if->core->rx_data.buf[free_idx] = rx_data;
+		if (free_idx >= 0) {
+			if (!buf[free_idx]) {
+				buf[free_idx] = rx_data;
+				rs_c_ring_prod_commit(buf_q);
 			} else {
-				RS_ERR("rx q push err : uidx[%d]:ucnt[%d]:fidx[%d]\n",
-				       c_if->core->rx_data.buf_q.used_idx,
-				       c_if->core->rx_data.buf_q.used_count,
-				       c_if->core->rx_data.buf_q.free_idx);
+				RS_ERR("rx q push err : head[%u]:tail[%u]:fidx[%d]\n", buf_q->head,
+				       buf_q->tail, free_idx);
+				free_idx = RS_FAIL;
 			}
-			// check full
-			// free_idx = rs_c_q_full(&(c_if->core->rx_data.buf_q));
-		} else {
-			RS_ERR("rx full[%d]\n", free_idx);
 		}
-
-		C_RX_DATA_SPIN_UNLOCK(c_if);
 	}
 
 	if (free_idx >= 0) {
@@ -101,80 +132,121 @@ static rs_ret c_rx_data_push(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data)
 	return ret;
 }
 
-static rs_ret c_rx_data_pop(struct rs_c_if *c_if, struct rs_c_rx_data **rx_data)
+// Pop up to max_count rx data at once, returns popped count
+static u32 c_rx_data_pop_n(struct rs_c_ring *buf_q, struct rs_c_rx_data **buf, struct rs_c_rx_data **rx_data,
+			   u32 max_count)
 {
-	rs_ret ret = RS_FAIL;
-	s32 used_idx = RS_FAIL;
+	u32 count = 0;
+	u32 first_idx = 0;
+	u32 used_idx = 0;
+	u32 i = 0;
+
+	if (buf_q && buf && rx_data) {
+		count = rs_c_ring_cons_n(buf_q, max_count, &first_idx);
+
+		for (i = 0; i < count; i++) {
+			used_idx = RS_C_RING_IDX(buf_q, first_idx, i);
+
+			rx_data[i] = buf[used_idx];
+			buf[used_idx] = NULL;
+			if (!rx_data[i]) {
+				RS_ERR("rx q pop err : head[%u]:tail[%u]:uidx[%u]\n", buf_q->head,
+				       buf_q->tail, used_idx);
+			}
+		}
 
-	if (c_if && c_if->core && rx_data) {
-		C_RX_DATA_SPIN_LOCK(c_if);
+		rs_c_ring_cons_commit_n(buf_q, count);
+	}
 
-		used_idx = rs_c_q_pop(&c_if->core->rx_data.buf_q);
+	return count;
+}
 
-		if (used_idx != RS_EMPTY) {
-			if (c_if->core->rx_data.buf[used_idx]) {
-				*rx_data = c_if->core->rx_data.buf[used_idx];
-				c_if->core->rx_data.buf[used_idx] = NULL;
-			} else {
-				RS_ERR("rx q pop err : uidx[%d]:ucnt[%d]:fidx[%d]\n",
-				       c_if->core->rx_data.buf_q.used_idx,
-				       c_if->core->rx_data.buf_q.used_count,
-				       c_if->core->rx_data.buf_q.free_idx);
+static rs_ret c_rx_data_q_free(struct rs_c_if *c_if, struct rs_c_ring *buf_q, struct rs_c_rx_data **buf)
+{
+	rs_ret ret = RS_SUCCESS;
+	struct rs_c_rx_data *temp_rx_data[C_RX_DATA_BATCH] = { NULL };
+	u32 count = 0;
+	u32 i = 0;
+
+	while ((count = c_rx_data_pop_n(buf_q, buf, temp_rx_data, C_RX_DATA_BATCH)) > 0) {
+		for (i = 0; i < count; i++) {
+			if (temp_rx_data[i]) {
+				rs_c_pool_put(&c_if->core->rx_pool, temp_rx_data[i]);
+				temp_rx_data[i] = NULL;
 			}
 		}
-
-		C_RX_DATA_SPIN_UNLOCK(c_if);
 	}
 
-	if (used_idx >= 0) {
-		ret = RS_SUCCESS;
+	return ret;
+}
+
+// Hand RX data to network, its buffer is put back unless network took it as sk_buff
+static rs_ret c_rx_data_deliver(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data)
+{
+	rs_ret ret = RS_FAIL;
+	bool taken = FALSE;
+
+	ret = rs_net_rx_data(c_if, rx_data, &taken);
+	if (taken == TRUE) {
+		rs_c_pool_detach(&c_if->core->rx_pool, rx_data);
 	} else {
-		// RS_DBG("P:%s[%d]:skb NULL!![%d]\n", __func__, __LINE__, used_idx);
-		ret = used_idx;
+		rs_c_pool_put(&c_if->core->rx_pool, rx_data);
 	}
 
 	return ret;
 }
 
-static rs_ret c_rx_data_q_free(struct rs_c_if *c_if)
+// Queue of data frame, a station TID never spans queues as its reordering and order are per TID
+static u8 c_rx_data_q_idx(struct rs_core *core, struct rs_c_rx_ext_hdr *ext_hdr)
 {
-	rs_ret ret = RS_FAIL;
-	struct rs_c_rx_data *temp_rx_data = NULL;
+	u32 key = 0;
+	u8 q_num = core->rx_data.q_num;
+	u8 q_idx = 0;
+
+	if (q_num > 1) {
+		key = ((u32)ext_hdr->vif_idx << 16) | ((u32)ext_hdr->sta_idx << 8) | ext_hdr->priority;
+		q_idx = (u8)(((key * C_RX_DATA_Q_HASH) >> 16) % q_num);
+	}
 
-	while ((ret = c_rx_data_pop(c_if, &temp_rx_data)) >= RS_SUCCESS) {
-		if (temp_rx_data) {
-			rs_k_free(temp_rx_data);
-			temp_rx_data = NULL;
+	return q_idx;
+}
+
+#ifndef CONFIG_RS_NAPI
+// Deliver up to one batch of queue, returns delivered count
+static u32 c_rx_data_drain(struct rs_c_if *c_if, struct rs_c_ring *buf_q, struct rs_c_rx_data **buf)
+{
+	struct rs_c_rx_data *temp_rx_data[C_RX_DATA_BATCH] = { NULL };
+	u32 count = 0;
+	u32 i = 0;
+
+	count = c_rx_data_pop_n(buf_q, buf, temp_rx_data, C_RX_DATA_BATCH);
+	for (i = 0; i < count; i++) {
+		if (temp_rx_data[i]) {
+			(void)c_rx_data_deliver(c_if, temp_rx_data[i]);
+			temp_rx_data[i] = NULL;
 		}
 	}
 
-	return ret;
+	return count;
 }
 
 static rs_ret c_rx_data(struct rs_c_if *c_if)
 {
-	rs_ret ret = RS_FAIL;
-	struct rs_c_rx_data *temp_rx_data = NULL;
-
-	while ((rs_c_q_empty(&c_if->core->rx_data.buf_q) != RS_EMPTY)
-#ifdef C_RX_THREAD
-	       && (rs_k_thread_is_running() == RS_SUCCESS)
-#endif
-	) {
-		ret = c_rx_data_pop(c_if, &temp_rx_data);
-		if (ret == RS_SUCCESS) {
-			ret = rs_net_rx_data(c_if, temp_rx_data);
-		}
+	rs_ret ret = RS_SUCCESS;
+	u32 count = 0;
 
-		if (temp_rx_data) {
-			rs_k_free(temp_rx_data);
-			temp_rx_data = NULL;
+	do {
+		// management queue is emptied before each data batch, it waits for one batch at most
+		while (c_rx_data_drain(c_if, &c_if->core->rx_data.mgmt_q, c_if->core->rx_data.mgmt_buf) > 0) {
 		}
-	}
 
-	if (temp_rx_data) {
-		RS_DBG("P:%s[%d]:rx_data memory leak!!:[%d]\n", __func__, __LINE__, ret);
-	}
+		count = c_rx_data_drain(c_if, &c_if->core->rx_data.q[0].buf_q,
+					c_if->core->rx_data.q[0].buf);
+	} while (
+#ifdef C_RX_THREAD
+		(rs_k_thread_is_running() == RS_SUCCESS) &&
+#endif
+		(count > 0));
 
 	return ret;
 }
@@ -221,24 +293,59 @@ static void c_rx_data_work_handler(void *param)
 }
 
 #endif
+#endif /* CONFIG_RS_NAPI */
 
 // Post RX DATA event
 static rs_ret rs_c_rx_data_event_post(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data)
 {
 	rs_ret ret = RS_FAIL;
+	struct rs_c_rx_data_q *q = NULL;
+	u8 q_idx = 0;
 
 	if (c_if && c_if->core) {
+		q = &c_if->core->rx_data.q[0];
 		if (rx_data) {
 			// update data status
 			if (rx_data->ext_len == RS_C_RX_EXT_LEN) {
 				rs_c_set_status(c_if, rx_data->ext_hdr.status);
 			}
 
-			// push rx data
-			ret = c_rx_data_push(c_if, rx_data);
+			// management frame is never dropped for data, data is dropped when its queue is full
+			if ((rx_data->ext_len == RS_C_RX_EXT_LEN) && (rx_data->ext_hdr.mpdu == 1)) {
+				RS_C_DBG_STAT_INC(rx.nb_mgmt);
+#ifdef CONFIG_RS_NAPI
+				// management frame may need process context in cfg80211, not left to softirq
+				(void)c_rx_data_deliver(c_if, rx_data);
+#else
+				ret = c_rx_data_push(&c_if->core->rx_data.mgmt_q,
+						     c_if->core->rx_data.mgmt_buf, rx_data);
+				if (ret != RS_SUCCESS) {
+					// RX thread is process context as well, frame only loses its order
+					RS_C_DBG_STAT_INC(rx.nb_mgmt_inline);
+					(void)c_rx_data_deliver(c_if, rx_data);
+				}
+#endif
+				rx_data = NULL;
+				ret = RS_SUCCESS;
+			} else {
+				if (rx_data->ext_len == RS_C_RX_EXT_LEN) {
+					q_idx = c_rx_data_q_idx(c_if->core, &rx_data->ext_hdr);
+				}
+				q = &c_if->core->rx_data.q[q_idx];
+				ret = c_rx_data_push(&q->buf_q, q->buf, rx_data);
+				if (ret != RS_SUCCESS) {
+					RS_C_DBG_STAT_INC(rx.nb_drop);
+				}
+			}
 		}
-		if (rs_c_q_empty(&c_if->core->rx_data.buf_q) != RS_EMPTY) {
-#ifdef C_RX_THREAD
+		if ((rs_c_ring_empty(&q->buf_q) != RS_EMPTY)
+#ifndef CONFIG_RS_NAPI
+		    || (rs_c_ring_empty(&c_if->core->rx_data.mgmt_q) != RS_EMPTY)
+#endif
+		) {
+#if defined(CONFIG_RS_NAPI)
+			rs_net_rx_data_schedule(c_if, q_idx);
+#elif defined(C_RX_THREAD)
 			(void)rs_k_event_post(c_if->core->rx_data.event, RS_C_RX_DATA_EVENT);
 #else
 			ret = rs_k_workqueue_add_work(c_if->core->wq, &(c_if->core->rx_data.work));
@@ -251,12 +358,170 @@ static rs_ret rs_c_rx_data_event_post(struct rs_c_if *c_if, struct rs_c_rx_data
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// Hand one IF frame to its handler, *rx_buf is cleared when the handler keeps buffer
+static rs_ret c_rx_dispatch(struct rs_c_if *c_if, u8 **rx_buf)
+{
+	rs_ret ret = RS_FAIL;
+	u8 cmd_id = 0;
+
+	cmd_id = ((struct rs_c_data *)*rx_buf)->cmd;
+
+	if (RS_C_IS_DATA_RX(cmd_id)) {
+		// RX DATA
+		ret = rs_c_rx_data_event_post(c_if, (struct rs_c_rx_data *)*rx_buf);
+		if (ret == RS_SUCCESS) {
+			*rx_buf = NULL;
+		}
+	} else if (RS_C_IS_STATUS_RX(cmd_id)) {
+		ret = c_rx_status_set(c_if, (struct rs_c_rx_status *)*rx_buf);
+	} else if (RS_C_IS_COMMON_CMD(cmd_id) || RS_C_IS_FMAC_CTRL_CMD(cmd_id) || RS_C_IS_DBG_CMD(cmd_id)) {
+		// Response
+		ret = rs_c_ctrl_event_post(c_if, (struct rs_c_ctrl_rsp *)*rx_buf);
+	} else if (RS_C_IS_FMAC_INDI_CMD(cmd_id)) {
+		// Indication
+		ret = rs_c_indi_event_post(c_if, (struct rs_c_indi *)*rx_buf);
+		if (ret == RS_SUCCESS) {
+			*rx_buf = NULL;
+		}
+	} else {
+		// TODO
+		RS_INFO("P:%s[%d]:cmd_id[%d]\n", __func__, __LINE__, cmd_id);
+		ret = RS_NOT_SUPPORT;
+	}
+
+	return ret;
+}
+
+// Split aggregated read into records, each is copied to its own buffer and dispatched
+static rs_ret c_rx_agg(struct rs_c_if *c_if, struct rs_c_data *agg)
+{
+	rs_ret ret = RS_SUCCESS;
+	struct rs_c_data *rec = NULL;
+	u8 *rec_buf = NULL;
+	u32 pos = 0;
+	u32 end = 0;
+	u32 rec_len = 0;
+
+	c_if->core->rx.agg_cnt++;
+
+	pos = RS_C_GET_DATA_SIZE(agg->ext_len, 0);
+	end = RS_C_GET_DATA_SIZE(agg->ext_len, agg->data_len);
+	if (end > RS_C_RX_BUF_SIZE) {
+		RS_ERR("rx agg len err [%u]\n", end);
+		c_if->core->rx.agg_err_cnt++;
+		ret = RS_FAIL;
+		end = pos;
+	}
+
+	while ((pos + RS_C_BASE_HDR_SIZE) <= end) {
+		rec = (struct rs_c_data *)((u8 *)agg + pos);
+		rec_len = RS_C_GET_DATA_SIZE(rec->ext_len, rec->data_len);
+		if ((rec_len > (end - pos)) || !RS_C_IS_CMD(rec->cmd) || RS_C_IS_DATA_RX_AGG(rec->cmd)) {
+			RS_ERR("rx agg rec err cmd[%d]:len[%u]:pos[%u]:end[%u]\n", rec->cmd, rec_len, pos,
+			       end);
+			c_if->core->rx.agg_err_cnt++;
+			ret = RS_FAIL;
+			break;
+		}
+
+		rec_buf = rs_c_pool_get(&c_if->core->rx_pool);
+		if (!rec_buf) {
+			ret = RS_MEMORY_FAIL;
+			break;
+		}
+
+		(void)rs_k_memcpy(rec_buf, rec, rec_len);
+		c_if->core->rx.agg_rec_cnt++;
+
+		(void)c_rx_dispatch(c_if, &rec_buf);
+		if (rec_buf) {
+			rs_c_pool_put(&c_if->core->rx_pool, rec_buf);
+			rec_buf = NULL;
+		}
+
+		pos += RS_C_AGG_REC_SIZE(rec_len);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_RS_SELFTEST
+// Read of mock I/F, copies image of its bus
+static rs_ret c_rx_mock_readv(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+	struct c_rx_mock_bus *bus = c_if->if_dev.dev_if_priv;
+
+	if (bus && (frag_num == 1) && frag[0].data && (bus->len <= frag[0].len)) {
+		(void)rs_k_memcpy(frag[0].data, bus->image, bus->len);
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+// Append record with data_len bytes of payload to aggregated read, returns its aligned size
+static u32 c_rx_selftest_rec(u8 *image, u32 pos, u8 cmd, u16 data_len)
+{
+	struct rs_c_data *rec = (struct rs_c_data *)(image + pos);
+
+	rec->cmd = cmd;
+	rec->ext_len = 0;
+	rec->data_len = data_len;
+	(void)rs_k_memset(rec->data, (u8)pos, data_len);
+
+	return RS_C_AGG_REC_SIZE(RS_C_GET_DATA_SIZE(0, data_len));
+}
+
+// Build aggregated read of test case into image, returns its length
+static u32 c_rx_selftest_build(u8 *image, u8 test)
+{
+	struct rs_c_data *agg = (struct rs_c_data *)image;
+	u32 pos = RS_C_GET_DATA_SIZE(0, 0);
+	u32 rec_pos = 0;
+
+	(void)rs_k_memset(image, 0, RS_C_RX_BUF_SIZE);
+	agg->cmd = RS_CMD_DATA_RX_AGG;
+
+	switch (test) {
+	case C_RX_SELFTEST_MULTI:
+		// unaligned records, each next one starts aligned
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 10);
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 64);
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 1);
+		agg->data_len = pos - RS_C_GET_DATA_SIZE(0, 0);
+		break;
+	case C_RX_SELFTEST_TRUNC:
+		// header of second record is in, its payload runs past end
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 16);
+		rec_pos = pos;
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 32);
+		agg->data_len = rec_pos + RS_C_BASE_HDR_SIZE + 8 - RS_C_GET_DATA_SIZE(0, 0);
+		break;
+	case C_RX_SELFTEST_OVERSIZE:
+		// end past RX buffer, no record is taken
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 16);
+		agg->data_len = RS_C_RX_BUF_SIZE;
+		break;
+	case C_RX_SELFTEST_NESTED:
+		pos += c_rx_selftest_rec(image, pos, C_RX_SELFTEST_REC_CMD, 16);
+		pos += c_rx_selftest_rec(image, pos, RS_CMD_DATA_RX_AGG, 16);
+		agg->data_len = pos - RS_C_GET_DATA_SIZE(0, 0);
+		break;
+	default:
+		break;
+	}
+
+	return pos;
+}
+#endif
+
 // RX
 static rs_ret c_rx_push(struct rs_c_if *c_if)
 {
 	rs_ret ret = RS_SUCCESS;
 	u8 *temp_rx_buf = NULL;
-	u8 cmd_id = 0;
+	struct rs_c_if_frag seg = { 0 };
 
 	while (
 #ifdef C_RX_THREAD
@@ -266,38 +531,24 @@ static rs_ret c_rx_push(struct rs_c_if *c_if)
 #endif
 	) {
 		if (!temp_rx_buf) {
-			temp_rx_buf = rs_k_calloc(sizeof(struct rs_c_rx_data));
+			temp_rx_buf = rs_c_pool_get(&c_if->core->rx_pool);
 		}
 		if (temp_rx_buf) {
-			ret = rs_c_if_read(c_if, RS_C_IF_READ_CMD, (u8 *)temp_rx_buf,
-					   sizeof(struct rs_c_rx_data));
+			// frame may carry status, TX credit in flight is counted from here
+			rs_c_status_rx_mark(c_if);
+			// pool buffer is DMA capable, bus reads into it without bounce copy
+			seg.data = temp_rx_buf;
+			seg.len = RS_C_RX_BUF_SIZE;
+			ret = rs_c_if_readv(c_if, RS_C_IF_READ_CMD, &seg, 1);
 
 			if (ret >= RS_SUCCESS) {
-				cmd_id = ((struct rs_c_rx_data *)temp_rx_buf)->cmd;
-
-				if (RS_C_IS_DATA_RX(cmd_id)) {
-					// RX DATA
-					ret = rs_c_rx_data_event_post(c_if,
-								      (struct rs_c_rx_data *)temp_rx_buf);
-					if (ret == RS_SUCCESS) {
-						temp_rx_buf = NULL;
-					}
-				} else if (RS_C_IS_STATUS_RX(cmd_id)) {
-					ret = c_rx_status_set(c_if, (struct rs_c_rx_status *)temp_rx_buf);
-				} else if (RS_C_IS_COMMON_CMD(cmd_id) || RS_C_IS_FMAC_CTRL_CMD(cmd_id) ||
-					   RS_C_IS_DBG_CMD(cmd_id)) {
-					// Response
-					ret = rs_c_ctrl_event_post(c_if, (struct rs_c_ctrl_rsp *)temp_rx_buf);
-				} else if (RS_C_IS_FMAC_INDI_CMD(cmd_id)) {
-					// Indication
-					ret = rs_c_indi_event_post(c_if, (struct rs_c_indi *)temp_rx_buf);
-					if (ret == RS_SUCCESS) {
-						temp_rx_buf = NULL;
-					}
+				if (RS_C_IS_DATA_RX_AGG(((struct rs_c_data *)temp_rx_buf)->cmd)) {
+					ret = c_rx_agg(c_if, (struct rs_c_data *)temp_rx_buf);
 				} else {
-					// TODO
-					RS_INFO("P:%s[%d]:cmd_id[%d]\n", __func__, __LINE__, cmd_id);
-					break;
+					ret = c_rx_dispatch(c_if, &temp_rx_buf);
+					if (ret == RS_NOT_SUPPORT) {
+						break;
+					}
 				}
 			}
 		}
@@ -308,7 +559,7 @@ static rs_ret c_rx_push(struct rs_c_if *c_if)
 	}
 
 	if (temp_rx_buf) {
-		rs_k_free(temp_rx_buf);
+		rs_c_pool_put(&c_if->core->rx_pool, temp_rx_buf);
 		temp_rx_buf = NULL;
 	}
 
@@ -409,21 +660,48 @@ rs_ret rs_c_rx_deinit(struct rs_c_if *c_if)
 rs_ret rs_c_rx_data_init(struct rs_c_if *c_if, u16 rx_buf_num)
 {
 	rs_ret ret = RS_FAIL;
+	struct rs_c_rx_data_q *q = NULL;
+	u8 i = 0;
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
 	// RX DATA
 	if (c_if && c_if->core && (rx_buf_num > 0)) {
-		C_RX_DATA_SPIN_LOCK_INIT(c_if);
+		// net spreads frames over more queues once its NAPIs are there
+		c_if->core->rx_data.q_num = 1;
+		c_if->core->rx_data.buf_num = rx_buf_num;
+		ret = RS_SUCCESS;
 
-		c_if->core->rx_data.buf =
-			(struct rs_c_rx_data **)rs_k_calloc(rx_buf_num * sizeof(struct rs_c_rx_data));
-		if (c_if->core->rx_data.buf) {
-			c_if->core->rx_data.buf_num = rx_buf_num;
-			ret = rs_c_q_init(&c_if->core->rx_data.buf_q, rx_buf_num);
+		for (i = 0; (i < RS_C_RX_DATA_Q_MAX) && (ret == RS_SUCCESS); i++) {
+			q = &c_if->core->rx_data.q[i];
+			q->buf = (struct rs_c_rx_data **)rs_k_calloc(rx_buf_num *
+								     sizeof(struct rs_c_rx_data *));
+			if (q->buf) {
+				ret = rs_c_ring_init(&q->buf_q, rx_buf_num);
+			} else {
+				ret = RS_MEMORY_FAIL;
+			}
+		}
 
-#ifdef C_RX_THREAD
-			c_if->core->rx_data.event = rs_k_calloc(sizeof(struct rs_k_event));
+		if (ret == RS_SUCCESS) {
+#ifndef CONFIG_RS_NAPI
+			if (ret == RS_SUCCESS) {
+				c_if->core->rx_data.mgmt_buf = (struct rs_c_rx_data **)rs_k_calloc(
+					C_RX_MGMT_BUF_NUM * sizeof(struct rs_c_rx_data *));
+				if (c_if->core->rx_data.mgmt_buf) {
+					ret = rs_c_ring_init(&c_if->core->rx_data.mgmt_q, C_RX_MGMT_BUF_NUM);
+				} else {
+					ret = RS_MEMORY_FAIL;
+				}
+			}
+#endif
+
+#if defined(CONFIG_RS_NAPI)
+			// NAPI is added by net, frames wait in queue until then
+#elif defined(C_RX_THREAD)
+			if (ret == RS_SUCCESS) {
+				c_if->core->rx_data.event = rs_k_calloc(sizeof(struct rs_k_event));
+			}
 			if (c_if->core->rx_data.event) {
 				ret = rs_k_event_create(c_if->core->rx_data.event);
 			} else {
@@ -435,12 +713,11 @@ rs_ret rs_c_rx_data_init(struct rs_c_if *c_if, u16 rx_buf_num)
 							(u8 *)C_RX_DATA_THREAD_NAME);
 			}
 #else
-			ret = rs_k_workqueue_init_work(&(c_if->core->rx_data.work), c_rx_data_work_handler,
-						       c_if);
+			if (ret == RS_SUCCESS) {
+				ret = rs_k_workqueue_init_work(&(c_if->core->rx_data.work),
+							       c_rx_data_work_handler, c_if);
+			}
 #endif
-		} else {
-			c_if->core->rx_data.buf_num = 0;
-			ret = RS_MEMORY_FAIL;
 		}
 	}
 
@@ -450,11 +727,15 @@ rs_ret rs_c_rx_data_init(struct rs_c_if *c_if, u16 rx_buf_num)
 rs_ret rs_c_rx_data_deinit(struct rs_c_if *c_if)
 {
 	rs_ret ret = RS_FAIL;
+	struct rs_c_rx_data_q *q = NULL;
+	u8 i = 0;
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
 	if (c_if && c_if->core) {
-#ifdef C_RX_THREAD
+#if defined(CONFIG_RS_NAPI)
+		// NAPI is deleted by net before
+#elif defined(C_RX_THREAD)
 		(void)rs_k_event_post(c_if->core->rx_data.event, K_EVENT_EXIT);
 		ret = rs_k_thread_destroy(&c_if->core->rx_data.thread);
 #else
@@ -462,17 +743,160 @@ rs_ret rs_c_rx_data_deinit(struct rs_c_if *c_if)
 #endif
 
 		// free Q
-		ret = c_rx_data_q_free(c_if);
+		ret = RS_SUCCESS;
+		for (i = 0; i < RS_C_RX_DATA_Q_MAX; i++) {
+			q = &c_if->core->rx_data.q[i];
+			if (q->buf) {
+				(void)c_rx_data_q_free(c_if, &q->buf_q, q->buf);
+				rs_k_free(q->buf);
+				q->buf = NULL;
+			}
+		}
+		c_if->core->rx_data.q_num = 0;
+		c_if->core->rx_data.buf_num = 0;
+#ifndef CONFIG_RS_NAPI
+		if (c_if->core->rx_data.mgmt_buf) {
+			(void)c_rx_data_q_free(c_if, &c_if->core->rx_data.mgmt_q,
+					       c_if->core->rx_data.mgmt_buf);
+			rs_k_free(c_if->core->rx_data.mgmt_buf);
+			c_if->core->rx_data.mgmt_buf = NULL;
+		}
+#endif
+	}
 
-		// free buf
-		if (c_if->core->rx_data.buf) {
-			rs_k_free(c_if->core->rx_data.buf);
-			c_if->core->rx_data.buf = NULL;
-			c_if->core->rx_data.buf_num = 0;
+	return ret;
+}
+
+#ifdef CONFIG_RS_NAPI
+rs_ret rs_c_rx_data_set_q_num(struct rs_c_if *c_if, u8 q_num)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->core && (q_num > 0) && (q_num <= RS_C_RX_DATA_Q_MAX)) {
+		c_if->core->rx_data.q_num = q_num;
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+u8 rs_c_rx_data_q_idx(struct rs_c_if *c_if, struct rs_c_rx_ext_hdr *ext_hdr)
+{
+	u8 q_idx = 0;
+
+	if (c_if && c_if->core && ext_hdr) {
+		q_idx = c_rx_data_q_idx(c_if->core, ext_hdr);
+	}
+
+	return q_idx;
+}
+
+u32 rs_c_rx_data_poll(struct rs_c_if *c_if, u8 q_idx, u32 budget)
+{
+	struct rs_c_rx_data *temp_rx_data[C_RX_DATA_BATCH] = { NULL };
+	struct rs_c_rx_data_q *q = NULL;
+	u32 done = 0;
+	u32 max_count = 0;
+	u32 count = 0;
+	u32 i = 0;
+
+	if (c_if && c_if->core && (q_idx < RS_C_RX_DATA_Q_MAX)) {
+		q = &c_if->core->rx_data.q[q_idx];
+		while (done < budget) {
+			max_count = budget - done;
+			if (max_count > C_RX_DATA_BATCH) {
+				max_count = C_RX_DATA_BATCH;
+			}
+
+			count = c_rx_data_pop_n(&q->buf_q, q->buf, temp_rx_data, max_count);
+			if (count == 0) {
+				break;
+			}
+
+			for (i = 0; i < count; i++) {
+				if (temp_rx_data[i]) {
+					(void)c_rx_data_deliver(c_if, temp_rx_data[i]);
+					temp_rx_data[i] = NULL;
+				}
+			}
+			done += count;
 		}
+	}
+
+	return done;
+}
+#endif
 
-		C_RX_DATA_SPIN_LOCK_DEINIT(c_if);
+#ifdef CONFIG_RS_SELFTEST
+rs_ret rs_c_rx_agg_selftest(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_if *mock_if = NULL;
+	struct c_rx_mock_bus bus = { 0 };
+	struct rs_c_if_frag seg = { 0 };
+	u8 *rx_buf = NULL;
+	u32 rec_cnt = 0;
+	u32 err_cnt = 0;
+	rs_ret agg_ret = RS_FAIL;
+	u8 test = 0;
+
+	// mock I/F has own core, counters and pool of device are untouched
+	mock_if = rs_k_calloc(sizeof(struct rs_c_if));
+	if (c_if && mock_if) {
+		mock_if->core = rs_k_calloc(sizeof(struct rs_core));
+		bus.image = rs_k_calloc(RS_C_RX_BUF_SIZE);
+	}
+
+	if (mock_if && mock_if->core && bus.image &&
+	    (rs_c_pool_init(&mock_if->core->rx_pool, RS_C_RX_BUF_SIZE, 2, 0, 2, NULL) == RS_SUCCESS)) {
+		mock_if->if_dev.dev_if_priv = &bus;
+		mock_if->if_ops.readv = c_rx_mock_readv;
+
+		ret = RS_SUCCESS;
+		for (test = 0; (test < C_RX_SELFTEST_NUM) && (ret == RS_SUCCESS); test++) {
+			bus.len = c_rx_selftest_build(bus.image, test);
+			rec_cnt = mock_if->core->rx.agg_rec_cnt;
+			err_cnt = mock_if->core->rx.agg_err_cnt;
+
+			rx_buf = rs_c_pool_get(&mock_if->core->rx_pool);
+			seg.data = rx_buf;
+			seg.len = RS_C_RX_BUF_SIZE;
+			ret = rs_c_if_readv(mock_if, RS_C_IF_READ_CMD, &seg, 1);
+			if ((ret == RS_SUCCESS) && RS_C_IS_DATA_RX_AGG(((struct rs_c_data *)rx_buf)->cmd)) {
+				agg_ret = c_rx_agg(mock_if, (struct rs_c_data *)rx_buf);
+				rec_cnt = mock_if->core->rx.agg_rec_cnt - rec_cnt;
+				err_cnt = mock_if->core->rx.agg_err_cnt - err_cnt;
+
+				if ((agg_ret != c_rx_selftest_expect[test].ret) ||
+				    (rec_cnt != c_rx_selftest_expect[test].rec_cnt) ||
+				    (err_cnt != c_rx_selftest_expect[test].err_cnt)) {
+					RS_ERR("rx agg selftest [%u]:ret[%d]:rec[%u]:err[%u]\n", test,
+					       agg_ret, rec_cnt, err_cnt);
+					ret = RS_FAIL;
+				}
+			} else {
+				ret = RS_FAIL;
+			}
+
+			if (rx_buf) {
+				rs_c_pool_put(&mock_if->core->rx_pool, rx_buf);
+				rx_buf = NULL;
+			}
+		}
+
+		(void)rs_c_pool_deinit(&mock_if->core->rx_pool);
+	}
+
+	if (bus.image) {
+		rs_k_free(bus.image);
+	}
+	if (mock_if) {
+		if (mock_if->core) {
+			rs_k_free(mock_if->core);
+		}
+		rs_k_free(mock_if);
 	}
 
 	return ret;
-}
\ No newline at end of file
+}
+#endif
@@ -9,6 +9,8 @@
 
 #include "rs_type.h"
 #include "rs_k_mem.h"
+#include "rs_k_atomic.h"
+#include "rs_k_time.h"
 #include "rs_c_dbg.h"
 #include "rs_c_if.h"
 #include "rs_core.h"
@@ -30,6 +32,11 @@
 #define C_STATUS_TX_POWER_AVAIL_CNT (2)
 #define C_STATUS_RESERVED	    (3)
 
+#define C_CREDIT_AVAIL_SHIFT	    (24)
+#define C_CREDIT_MARK_MASK	    (0x00FFFFFF)
+// bus status read interval while firmware reports no credit
+#define C_STATUS_STALL_RETRY_US	    (1000)
+
 #define C_STATUS_INIT(c_if)	    (void)rs_k_mutex_create(&c_if->core->status.mutex)
 #define C_STATUS_DEINIT(c_if)	    (void)rs_k_mutex_destroy(&c_if->core->status.mutex)
 #define C_STATUS_LOCK(c_if)	    (void)rs_k_mutex_lock(&c_if->core->status.mutex)
@@ -45,6 +52,43 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+static void c_status_mark(struct rs_c_if *c_if, u32 *mark)
+{
+	u8 ac = 0;
+
+	for (ac = 0; ac < RS_IF_DATA_MAX; ac++) {
+		mark[ac] = rs_k_atomic_load_acquire(&c_if->core->status.tx_written[ac]);
+	}
+}
+
+// Re-sync TX credit from reported status, frames written after mark are still counted in flight
+static void c_status_credit_sync(struct rs_c_if *c_if, const u32 *mark)
+{
+	u32 avail = 0;
+	u8 ac = 0;
+	bool wake = FALSE;
+
+	for (ac = 0; ac < RS_IF_DATA_MAX; ac++) {
+		avail = 0;
+		if (rs_c_get_status_tx(c_if, ac) == 0) {
+			avail = rs_c_get_status_tx_avail_cnt(c_if, ac);
+		}
+
+		rs_k_atomic_store_release(&c_if->core->status.credit_sync[ac],
+					  (avail << C_CREDIT_AVAIL_SHIFT) | (mark[ac] & C_CREDIT_MARK_MASK));
+
+		// credit is published before stall bit is tested, TX thread sets it before reading credit
+		if ((avail > 0) &&
+		    (rs_k_atomic_test_and_clear_bit(ac, &c_if->core->status.stall_flags) == TRUE)) {
+			wake = TRUE;
+		}
+	}
+
+	if (wake == TRUE) {
+		(void)rs_c_tx_event_post(c_if, RS_IF_DATA_MAX, 0, NULL);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
@@ -87,11 +131,17 @@ rs_ret rs_c_update_status(struct rs_c_if *c_if)
 {
 	rs_ret ret = RS_FAIL;
 
+	u32 mark[RS_IF_DATA_MAX] = { 0 };
+
 	if (c_if && c_if->core && c_if->core->status.value) {
 		C_STATUS_LOCK(c_if);
 		if (c_if->core->status.value) {
+			c_status_mark(c_if, mark);
 			ret = rs_c_if_read_status(c_if, (u8 *)(c_if->core->status.value),
 						  RS_CORE_STATUS_SIZE);
+			if (ret == RS_SUCCESS) {
+				c_status_credit_sync(c_if, mark);
+			}
 		}
 		C_STATUS_UNLOCK(c_if);
 
@@ -130,10 +180,93 @@ void rs_c_set_status_bits(struct rs_c_if *c_if, u8 status_bits)
 void rs_c_set_status(struct rs_c_if *c_if, u32 status)
 {
 	if ((c_if) && (c_if->core) && (c_if->core->status.value)) {
-		*((u32 *)(c_if->core->status.value)) = status;
+		// called by RX thread only, for status piggybacked on its last read
+		// TX thread reads status and syncs credit under lock, status of RX thread must not land
+		// between the two, or its older avail would be published with the newer mark of TX
+		C_STATUS_LOCK(c_if);
+		if (c_if->core->status.value) {
+			*((u32 *)(c_if->core->status.value)) = status;
+			c_status_credit_sync(c_if, c_if->core->status.rx_mark);
+		}
+		C_STATUS_UNLOCK(c_if);
+	}
+}
+
+// Sample TX written count before RX thread reads a frame which may carry status
+void rs_c_status_rx_mark(struct rs_c_if *c_if)
+{
+	if (c_if && c_if->core) {
+		c_status_mark(c_if, c_if->core->status.rx_mark);
 	}
 }
 
+// Count a frame written to bus, TX thread only
+void rs_c_status_tx_written(struct rs_c_if *c_if, u8 ac)
+{
+	if (c_if && c_if->core && (ac < RS_IF_DATA_MAX)) {
+		rs_k_atomic_store_release(&c_if->core->status.tx_written[ac],
+					  c_if->core->status.tx_written[ac] + 1);
+	}
+}
+
+// TX credit, reported avail count less frames written since it was read
+s32 rs_c_status_tx_credit(struct rs_c_if *c_if, u8 ac)
+{
+	s32 credit = 0;
+	u32 sync = 0;
+	u32 in_flight = 0;
+
+	if (c_if && c_if->core && (ac < RS_IF_DATA_MAX)) {
+		sync = rs_k_atomic_load_acquire(&c_if->core->status.credit_sync[ac]);
+		in_flight = (c_if->core->status.tx_written[ac] - sync) & C_CREDIT_MARK_MASK;
+
+		credit = (s32)(sync >> C_CREDIT_AVAIL_SHIFT) - (s32)in_flight;
+		if (credit < 0) {
+			credit = 0;
+		}
+	}
+
+	return credit;
+}
+
+// No TX credit left, read status from bus, once per C_STATUS_STALL_RETRY_US while stalled
+// Stall bit is set before credit is read, so a credit report coming meanwhile clears it and wakes TX
+s32 rs_c_status_tx_credit_refill(struct rs_c_if *c_if, u8 ac)
+{
+	s32 credit = 0;
+	u32 now_us = rs_k_time_get_us();
+
+	if (c_if && c_if->core && (ac < RS_IF_DATA_MAX)) {
+		if ((rs_k_atomic_test_and_set_bit(ac, &c_if->core->status.stall_flags) == FALSE) ||
+		    ((now_us - c_if->core->status.stall_us[ac]) >= C_STATUS_STALL_RETRY_US)) {
+			c_if->core->status.credit_read[ac]++;
+			(void)rs_c_update_status(c_if);
+			credit = rs_c_status_tx_credit(c_if, ac);
+
+			if (credit == 0) {
+				c_if->core->status.credit_stall[ac]++;
+				c_if->core->status.stall_us[ac] = now_us;
+			} else {
+				rs_k_atomic_clear_bit(ac, &c_if->core->status.stall_flags);
+			}
+		}
+	}
+
+	return credit;
+}
+
+// TX of ac waits for credit reported by firmware
+bool rs_c_status_tx_stalled(struct rs_c_if *c_if, u8 ac)
+{
+	bool stalled = FALSE;
+
+	if (c_if && c_if->core && (ac < RS_IF_DATA_MAX)) {
+		stalled = rs_k_atomic_test_bit(ac, &c_if->core->status.stall_flags);
+	}
+
+	return stalled;
+}
+
 u8 rs_c_get_status_rx(struct rs_c_if *c_if)
 {
 	u8 status = 0;
@@ -13,6 +13,9 @@
 #include "rs_k_thread.h"
 #include "rs_k_mem.h"
 #include "rs_k_spin_lock.h"
+#include "rs_k_time.h"
+#include "rs_k_timer.h"
+#include "rs_k_atomic.h"
 
 #include "rs_c_dbg.h"
 #include "rs_c_if.h"
@@ -29,7 +32,36 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
-#define C_TX_BUFFER_THRESHOLD (4)
+#define C_TX_BATCH	  (16)
+
+// DRR quantum, one maximum sized frame
+#define C_TX_DRR_QUANTUM  RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, RS_C_DATA_SIZE)
+
+#define C_TX_VIF_MASK_MAX (32)
+
+// stopped netdev queue is woken when its txq drained to depth / C_TX_WAKE_DIV
+#define C_TX_WAKE_DIV	  (2)
+
+#define C_TX_LANE_TID_NUM (2)
+// lower lane is served once after this many services of higher lanes
+#define C_TX_STARVE_LIMIT (16)
+
+// CoDel, drop when sojourn stayed above target for an interval
+#define C_TX_CODEL_TARGET_US   (5000)
+#define C_TX_CODEL_INTERVAL_US (100000)
+// firmware discards older frames anyway
+#define C_TX_LIFETIME_US       (RS_C_TX_LIFETIME_MS * 1000)
+
+#define C_TX_TIME_AFTER_EQ(a, b) ((s32)((a) - (b)) >= 0)
+
+// A-MSDU carries more than one frame of data
+#define C_TX_DATA_LEN_MAX(tx_hdr) \
+	((((tx_hdr)->ext_hdr.flags & RS_C_EXT_FLAGS_AMSDU) != 0) ? RS_C_TX_AMSDU_LEN : RS_C_DATA_SIZE)
+
+// deferred kick is posted by timer if burst does not end or no credit is reported
+#define C_TX_KICK_TIMEOUT_US	 (1000)
+// bit of kick_flags, set by xmit, TX thread and timer alike
+#define C_TX_KICK_PENDING	 (0)
 
 #ifdef C_TX_THREAD
 #define C_TX_THREAD_NAME "RSW_TX_THREAD"
@@ -47,21 +79,57 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
 
+// zero bytes aligning records of aggregated write
+static u8 c_tx_agg_pad[RS_C_AGG_ALIGN];
+
+// 802.1D user priority of each access category lane
+static const u8 c_tx_lane_tid[RS_C_TX_LANE_MAX][C_TX_LANE_TID_NUM] = {
+	{ 6, 7 }, // VO
+	{ 4, 5 }, // VI
+	{ 0, 3 }, // BE
+	{ 1, 2 }, // BK
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+static struct rs_c_txq *c_tx_get_txq(struct rs_c_if *c_if, u8 sta_idx, u8 tid)
+{
+	struct rs_c_txq *txq = NULL;
+	u16 txq_idx = 0;
+
+	if (c_if && c_if->core && c_if->core->tx_data.txq && (tid < RS_C_TX_TID_MAX)) {
+		txq_idx = (sta_idx * RS_C_TX_TID_MAX) + tid;
+		if (txq_idx < c_if->core->tx_data.txq_num) {
+			txq = &c_if->core->tx_data.txq[txq_idx];
+		}
+	}
+
+	return txq;
+}
+
 static rs_ret c_tx_push(struct rs_c_if *c_if, u8 ac, s8 vif_idx, u8 *tx_skb)
 {
 	rs_ret ret = RS_FAIL;
 	s32 free_idx = RS_FAIL;
-	struct rs_q *temp_q = NULL;
+	struct rs_c_ring *temp_q = NULL;
 	struct rs_c_q_buf *temp_buf = NULL;
+	struct rs_c_txq *txq = NULL;
+	struct rs_c_tx_hdr *tx_hdr = NULL;
+	u32 flow_hash = 0;
 
 	if (c_if && c_if->core && tx_skb) {
 		switch (ac) {
 		case IF_DATA_AC:
-			temp_q = &c_if->core->tx_data.buf_q;
-			temp_buf = c_if->core->tx_data.buf;
+			flow_hash = rs_net_skb_get_hash(tx_skb);
+			tx_hdr = rs_net_tx_data_hdr(tx_skb);
+			if (tx_hdr) {
+				txq = c_tx_get_txq(c_if, tx_hdr->ext_hdr.sta_idx, tx_hdr->ext_hdr.tid);
+			}
+			if (txq) {
+				temp_q = &txq->ring;
+				temp_buf = txq->buf;
+			}
 			break;
 		case IF_DATA_AC_POWER:
 			temp_q = &c_if->core->tx_data.buf_power_q;
@@ -72,31 +140,42 @@ static rs_ret c_tx_push(struct rs_c_if *c_if, u8 ac, s8 vif_idx, u8 *tx_skb)
 		}
 
 		if (temp_q && temp_buf) {
+			// several net contexts may push, the ring itself is single producer
 			C_TX_SPIN_LOCK(c_if);
 
-			free_idx = rs_c_q_push(temp_q);
+			free_idx = rs_c_ring_prod_idx(temp_q);
 
-			if (free_idx != RS_FULL) {
+			if (free_idx >= 0) {
 				if (!temp_buf[free_idx].data) {
 					temp_buf[free_idx].vif_idx = vif_idx;
 					temp_buf[free_idx].data = tx_skb;
+					temp_buf[free_idx].enq_us = rs_k_time_get_us();
+					temp_buf[free_idx].flow_hash = flow_hash;
+					// account before commit, TX thread may complete it right after
+					if (txq) {
+						rs_net_tx_data_queued(c_if, vif_idx, tx_skb);
+					}
+					rs_c_ring_prod_commit(temp_q);
 				} else {
-					RS_DBG("tx [%d] q push err : vi[%d]:uidx[%d]:ucnt[%d]:fidx[%d]\n", ac,
-					       vif_idx, temp_q->used_idx, temp_q->used_count,
-					       temp_q->free_idx);
+					RS_DBG("tx [%d] q push err : vi[%d]:head[%u]:tail[%u]:fidx[%d]\n", ac,
+					       vif_idx, temp_q->head, temp_q->tail, free_idx);
+					free_idx = RS_FAIL;
 				}
 			} else {
 				RS_DBG("tx [%d] full : [%d]\n", ac, free_idx);
 			}
 
-			// check full
-			ret = rs_c_q_full(temp_q);
-			if (ret == RS_FULL) {
-				// Stop net_if
-				(void)rs_net_if_tx_stop(c_if, vif_idx, TRUE);
+			// check full, stop only netdev queue of this station
+			ret = rs_c_ring_full(temp_q);
+			if ((ret == RS_FULL) && txq && (vif_idx >= 0) && (vif_idx < C_TX_VIF_MASK_MAX)) {
+				if (rs_net_if_txq_stop(c_if, vif_idx, txq->sta_idx, TRUE) == RS_SUCCESS) {
+					txq->stop_vif_mask |= RS_BIT(vif_idx);
+				}
 			}
 
 			C_TX_SPIN_UNLOCK(c_if);
+		} else {
+			RS_DBG("P:%s[%d]:no queue:ac[%d]\n", __func__, __LINE__, ac);
 		}
 	}
 
@@ -109,185 +188,763 @@ static rs_ret c_tx_push(struct rs_c_if *c_if, u8 ac, s8 vif_idx, u8 *tx_skb)
 	return ret;
 }
 
-static rs_ret c_tx_pop(struct rs_c_if *c_if, u8 ac, s8 *vif_idx, u8 **tx_skb)
+// Pop up to max_count tx buffers at once, returns popped count
+static u32 c_tx_pop_n(struct rs_c_ring *temp_q, struct rs_c_q_buf *temp_buf, struct rs_c_q_buf *tx_buf,
+		      u32 max_count)
 {
-	rs_ret ret = RS_FAIL;
-	s32 used_idx = RS_FAIL;
-	struct rs_q *temp_q = NULL;
-	struct rs_c_q_buf *temp_buf = NULL;
-	s8 temp_vif_idx = -1;
+	u32 count = 0;
+	u32 first_idx = 0;
+	u32 used_idx = 0;
+	u32 i = 0;
+
+	// TX thread is the only consumer, no lock needed
+	if (temp_q && temp_buf && tx_buf) {
+		count = rs_c_ring_cons_n(temp_q, max_count, &first_idx);
+
+		for (i = 0; i < count; i++) {
+			used_idx = RS_C_RING_IDX(temp_q, first_idx, i);
+
+			tx_buf[i] = temp_buf[used_idx];
+			if (!tx_buf[i].data) {
+				RS_DBG("tx q pop err : head[%u]:tail[%u]:uidx[%u]\n", temp_q->head,
+				       temp_q->tail, used_idx);
+			}
 
-	if (c_if && c_if->core) {
-		switch (ac) {
-		case IF_DATA_AC:
-			temp_q = &c_if->core->tx_data.buf_q;
-			temp_buf = c_if->core->tx_data.buf;
-			break;
-		case IF_DATA_AC_POWER:
-			temp_q = &c_if->core->tx_data.buf_power_q;
-			temp_buf = c_if->core->tx_data.buf_power;
-			break;
-		default:
-			break;
+			temp_buf[used_idx].data = NULL;
+			temp_buf[used_idx].vif_idx = -1;
 		}
 
-		if (temp_q && temp_buf) {
-			C_TX_SPIN_LOCK(c_if);
+		rs_c_ring_cons_commit_n(temp_q, count);
+	}
 
-			used_idx = rs_c_q_pop(temp_q);
+	return count;
+}
 
-			if (used_idx != RS_EMPTY) {
-				if (temp_buf[used_idx].data) {
-					if (tx_skb) {
-						*tx_skb = temp_buf[used_idx].data;
-					}
-					temp_vif_idx = temp_buf[used_idx].vif_idx;
-					if (vif_idx) {
-						*vif_idx = temp_vif_idx;
-					}
-					temp_buf[used_idx].data = NULL;
-					temp_buf[used_idx].vif_idx = -1;
+static void c_tx_ring_free(struct rs_c_ring *temp_q, struct rs_c_q_buf *temp_buf)
+{
+	struct rs_c_q_buf tx_buf[C_TX_BATCH];
+	u32 count = 0;
+	u32 i = 0;
+
+	while ((count = c_tx_pop_n(temp_q, temp_buf, tx_buf, C_TX_BATCH)) > 0) {
+		for (i = 0; i < count; i++) {
+			if (tx_buf[i].data) {
+				(void)rs_net_skb_free(tx_buf[i].data);
+				tx_buf[i].data = NULL;
+			}
+		}
+	}
+}
+
+static rs_ret c_tx_q_free(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_SUCCESS;
+	u16 i = 0;
+
+	if (c_if->core->tx_data.txq) {
+		for (i = 0; i < c_if->core->tx_data.txq_num; i++) {
+			c_tx_ring_free(&c_if->core->tx_data.txq[i].ring, c_if->core->tx_data.txq[i].buf);
+		}
+	}
 
+	c_tx_ring_free(&c_if->core->tx_data.buf_power_q, c_if->core->tx_data.buf_power);
+
+	return ret;
+}
+
+// Check any data frame is queued
+static bool c_tx_data_pending(struct rs_c_if *c_if)
+{
+	bool pending = FALSE;
+	u16 i = 0;
+
+	if (c_if->core->tx_data.txq) {
+		for (i = 0; (i < c_if->core->tx_data.txq_num) && (pending == FALSE); i++) {
+			if (rs_c_ring_empty(&c_if->core->tx_data.txq[i].ring) != RS_EMPTY) {
+				pending = TRUE;
+			}
+		}
+	}
+
+	return pending;
+}
+
+static rs_ret c_tx_data_send(struct rs_c_if *c_if, u8 *tx_skb)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_tx_hdr *tx_hdr = NULL;
+	struct rs_c_if_frag *frag = c_if->core->tx_data.frag;
+	u8 frag_num = 0;
+
+	if (tx_skb) {
+		tx_hdr = rs_net_tx_data_hdr(tx_skb);
+		if (tx_hdr) {
+			if (tx_hdr->ext_len == RS_C_TX_EXT_LEN &&
+			    tx_hdr->data_len <= C_TX_DATA_LEN_MAX(tx_hdr) && tx_hdr->data_len) {
+				// header and frame pieces go to bus as they are, no flattening copy
+				frag_num = rs_net_tx_data_frag(tx_skb, frag, RS_C_IF_FRAG_MAX);
+				if (frag_num > 0) {
+					ret = rs_c_if_writev(c_if, RS_C_IF_WRITE_CMD, frag, frag_num);
+				}
+				if (ret == RS_SUCCESS) {
+					RS_C_DBG_STAT_INC(tx.nb_sent);
+					if (frag_num > 2) {
+						c_if->core->tx_data.sg_cnt++;
+					}
 				} else {
-					RS_DBG("tx [%d] q pop err : vi[%d]:uidx[%d]:ucnt[%d]:fidx[%d]\n", ac,
-					       vif_idx, temp_q->used_idx, temp_q->used_count,
-					       temp_q->free_idx);
+					RS_C_DBG_STAT_INC(tx.nb_if_err);
 				}
+			} else {
+				RS_DBG("P:%s[%d]:ext_len[%d]:data_len[%d]\n", __func__, __LINE__,
+				       tx_hdr->ext_len, tx_hdr->data_len);
 			}
 
-			C_TX_SPIN_UNLOCK(c_if);
+			tx_hdr = NULL;
+		} else {
+			RS_DBG("P:%s[%d]:tx_hdr[%p]\n", __func__, __LINE__, tx_hdr);
 		}
 	}
 
-	if (used_idx >= 0) {
-		ret = RS_SUCCESS;
-	} else {
-		// RS_DBG("P:%s[%d]:skb NULL!![%d]\n", __func__, __LINE__, used_idx);
-		ret = used_idx;
+	return ret;
+}
+
+// Account frame in BQL and free it
+static void c_tx_buf_free(struct rs_c_if *c_if, u8 ac, struct rs_c_q_buf *tx_buf)
+{
+	if (ac == IF_DATA_AC) {
+		rs_net_tx_data_done(c_if, tx_buf->vif_idx, tx_buf->data);
+	}
+
+	(void)rs_net_skb_free(tx_buf->data);
+	tx_buf->data = NULL;
+}
+
+// Write frames held for aggregated write, single one goes without aggregation header
+static rs_ret c_tx_agg_flush(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_SUCCESS;
+	struct rs_c_if_frag *frag = c_if->core->tx_data.frag;
+	u8 cnt = c_if->core->tx_data.agg_cnt;
+	u8 i = 0;
+
+	if (cnt > 0) {
+		if (cnt == 1) {
+			ret = rs_c_if_writev(c_if, RS_C_IF_WRITE_CMD, &frag[1],
+					     c_if->core->tx_data.agg_frag_num - 1);
+		} else {
+			c_if->core->tx_data.agg_hdr.cmd = RS_CMD_DATA_TX_AGG;
+			c_if->core->tx_data.agg_hdr.ext_len = 0;
+			frag[0].data = (u8 *)&c_if->core->tx_data.agg_hdr;
+			frag[0].len = sizeof(struct rs_c_data_hdr);
+
+			ret = rs_c_if_writev(c_if, RS_C_IF_WRITE_CMD, frag,
+					     c_if->core->tx_data.agg_frag_num);
+			if (ret == RS_SUCCESS) {
+				c_if->core->tx_data.agg_write_cnt++;
+				c_if->core->tx_data.agg_frame_cnt += cnt;
+			}
+		}
+
+		for (i = 0; i < cnt; i++) {
+			if (ret == RS_SUCCESS) {
+				RS_C_DBG_STAT_INC(tx.nb_sent);
+				rs_c_status_tx_written(c_if, c_if->core->tx_data.agg_ac);
+			} else {
+				RS_C_DBG_STAT_INC(tx.nb_if_err);
+			}
+
+			c_tx_buf_free(c_if, c_if->core->tx_data.agg_ac, &c_if->core->tx_data.agg_buf[i]);
+		}
+
+		c_if->core->tx_data.agg_cnt = 0;
 	}
 
+	// header fragment is filled at write
+	c_if->core->tx_data.agg_frag_num = 1;
+	c_if->core->tx_data.agg_hdr.data_len = 0;
+
 	return ret;
 }
 
-static rs_ret c_tx_q_free(struct rs_c_if *c_if)
+// Hold frame for aggregated write, written before when it would not fit
+// returns RS_SUCCESS when frame is held, tx_buf is cleared then
+static rs_ret c_tx_agg_add(struct rs_c_if *c_if, u8 ac, struct rs_c_q_buf *tx_buf)
 {
 	rs_ret ret = RS_FAIL;
-	u8 *tx_skb = NULL;
+	struct rs_c_tx_hdr *tx_hdr = NULL;
+	struct rs_c_if_frag *frag = c_if->core->tx_data.frag;
+	u32 rec_len = 0;
+	u32 pad = 0;
+	u8 frag_num = 0;
+
+	tx_hdr = rs_net_tx_data_hdr(tx_buf->data);
+	if (tx_hdr && (tx_hdr->ext_len == RS_C_TX_EXT_LEN) &&
+	    (tx_hdr->data_len <= C_TX_DATA_LEN_MAX(tx_hdr)) && (tx_hdr->data_len > 0)) {
+		rec_len = RS_C_GET_DATA_SIZE(tx_hdr->ext_len, tx_hdr->data_len);
+		pad = RS_C_AGG_REC_SIZE(c_if->core->tx_data.agg_hdr.data_len) -
+		      c_if->core->tx_data.agg_hdr.data_len;
+
+		if ((c_if->core->tx_data.agg_cnt > 0) &&
+		    ((ac != c_if->core->tx_data.agg_ac) ||
+		     (c_if->core->tx_data.agg_cnt >= c_if->core->tx_data.agg_num) ||
+		     ((sizeof(struct rs_c_data_hdr) + c_if->core->tx_data.agg_hdr.data_len + pad + rec_len) >
+		      c_if->core->tx_data.agg_len))) {
+			(void)c_tx_agg_flush(c_if);
+			pad = 0;
+		}
 
-	while ((ret = c_tx_pop(c_if, IF_DATA_AC, NULL, &tx_skb)) >= RS_SUCCESS) {
-		if (tx_skb) {
-			(void)rs_net_skb_free(tx_skb);
-			tx_skb = NULL;
+		if (pad > 0) {
+			frag[c_if->core->tx_data.agg_frag_num].data = c_tx_agg_pad;
+			frag[c_if->core->tx_data.agg_frag_num].len = pad;
+		}
+
+		frag_num = c_if->core->tx_data.agg_frag_num + ((pad > 0) ? 1 : 0);
+		if (frag_num < RS_C_IF_FRAG_MAX) {
+			frag_num = rs_net_tx_data_frag(tx_buf->data, &frag[frag_num],
+						       RS_C_IF_FRAG_MAX - frag_num);
+		} else {
+			frag_num = 0;
 		}
-	}
 
-	while ((ret = c_tx_pop(c_if, IF_DATA_AC_POWER, NULL, &tx_skb)) >= RS_SUCCESS) {
-		if (tx_skb) {
-			(void)rs_net_skb_free(tx_skb);
-			tx_skb = NULL;
+		// out of fragments, frame starts next write
+		if ((frag_num == 0) && (c_if->core->tx_data.agg_cnt > 0)) {
+			(void)c_tx_agg_flush(c_if);
+			pad = 0;
+			frag_num = rs_net_tx_data_frag(tx_buf->data, &frag[1], RS_C_IF_FRAG_MAX - 1);
+		}
+
+		if (frag_num > 0) {
+			c_if->core->tx_data.agg_frag_num += ((pad > 0) ? 1 : 0) + frag_num;
+			c_if->core->tx_data.agg_hdr.data_len += pad + rec_len;
+			c_if->core->tx_data.agg_ac = ac;
+			c_if->core->tx_data.agg_buf[c_if->core->tx_data.agg_cnt] = *tx_buf;
+			c_if->core->tx_data.agg_cnt++;
+
+			tx_buf->data = NULL;
+			ret = RS_SUCCESS;
 		}
 	}
 
 	return ret;
 }
 
-static rs_ret c_tx_data_send(struct rs_c_if *c_if, u8 *tx_skb)
+// Send one popped frame if its vif is still up, then free it
+// With aggregation frame is held and freed once its aggregated write is done
+static rs_ret c_tx_buf_send(struct rs_c_if *c_if, u8 ac, struct rs_c_q_buf *tx_buf)
 {
 	rs_ret ret = RS_FAIL;
-	struct rs_c_tx_data *tx_data = NULL;
-	s32 len = 0;
 
-	if (tx_skb) {
-		(void)rs_net_skb_get_data(tx_skb, (u8 **)&tx_data);
-		if (tx_data) {
-			if (tx_data->ext_len == RS_C_TX_EXT_LEN && tx_data->data_len <= RS_C_DATA_SIZE &&
-			    tx_data->data_len) {
-				len = RS_C_GET_DATA_SIZE(tx_data->ext_len, tx_data->data_len);
-				ret = rs_c_if_write(c_if, RS_C_IF_WRITE_CMD, (u8 *)tx_data, len);
+	if (tx_buf->data) {
+		if (rs_net_vif_idx_is_up(c_if, tx_buf->vif_idx) == RS_SUCCESS) {
+			if (c_if->core->tx_data.agg_num > 1) {
+				ret = c_tx_agg_add(c_if, ac, tx_buf);
+			}
+
+			// frame of too many fragments goes alone
+			if (tx_buf->data) {
+				(void)c_tx_agg_flush(c_if);
+
+				ret = c_tx_data_send(c_if, tx_buf->data);
 				if (ret == RS_SUCCESS) {
-					rs_c_dbg_stat.tx.nb_sent++;
-				} else {
-					rs_c_dbg_stat.tx.nb_if_err++;
+					rs_c_status_tx_written(c_if, ac);
 				}
-			} else {
-				RS_DBG("P:%s[%d]:len[%d]:ext_len[%d]:data_len[%d]\n", __func__, __LINE__, len,
-				       tx_data->ext_len, tx_data->data_len);
 			}
+		} else {
+			RS_DBG("P:%s[%d]:skip!!:vif[%d]\n", __func__, __LINE__, tx_buf->vif_idx);
+		}
+
+		if (tx_buf->data) {
+			c_tx_buf_free(c_if, ac, tx_buf);
+		}
+	}
+
+	return ret;
+}
+
+// Send A-MSDU being built
+static void c_tx_amsdu_flush(struct rs_c_if *c_if)
+{
+	u8 cnt = c_if->core->tx_data.amsdu_cnt;
+
+	if (cnt > 0) {
+		c_if->core->tx_data.amsdu_hist[cnt - 1]++;
+		c_if->core->tx_data.amsdu_cnt = 0;
+
+		(void)c_tx_buf_send(c_if, IF_DATA_AC, &c_if->core->tx_data.amsdu_buf);
+	}
+}
+
+// Add frame popped from txq to A-MSDU being built, A-MSDU is sent before when frame does not fit
+// Frames of one txq share station and tid, first frame goes as plain frame if no other one follows.
+static void c_tx_amsdu_add(struct rs_c_if *c_if, struct rs_c_txq *txq, struct rs_c_q_buf *tx_buf)
+{
+	struct rs_c_q_buf *amsdu_buf = &c_if->core->tx_data.amsdu_buf;
+	u16 amsdu_len = c_if->core->tx_data.amsdu_len;
+
+	if (txq->amsdu_len < amsdu_len) {
+		amsdu_len = txq->amsdu_len;
+	}
+
+	if (c_if->core->tx_data.amsdu_cnt > 0) {
+		if ((c_if->core->tx_data.amsdu_cnt < c_if->core->tx_data.amsdu_num) &&
+		    (amsdu_buf->vif_idx == tx_buf->vif_idx) &&
+		    (rs_net_tx_data_amsdu(amsdu_buf->data, tx_buf->data, amsdu_len) == RS_SUCCESS)) {
+			// subframe is freed with A-MSDU
+			c_if->core->tx_data.amsdu_cnt++;
+			tx_buf->data = NULL;
+		} else {
+			c_tx_amsdu_flush(c_if);
+		}
+	}
+
+	if (tx_buf->data) {
+		*amsdu_buf = *tx_buf;
+		c_if->core->tx_data.amsdu_cnt = 1;
+		tx_buf->data = NULL;
+	}
+}
+
+// Wake netdev queues stopped on txq once it drained
+static void c_tx_txq_wake(struct rs_c_if *c_if, struct rs_c_txq *txq)
+{
+	s8 vif_idx = 0;
+
+	if ((txq->stop_vif_mask != 0) &&
+	    (rs_c_ring_count(&txq->ring) <= (c_if->core->tx_data.txq_depth / C_TX_WAKE_DIV))) {
+		// under producer lock, so a stop of racing push is not lost
+		C_TX_SPIN_LOCK(c_if);
+
+		for (vif_idx = 0; (vif_idx < C_TX_VIF_MASK_MAX) && (txq->stop_vif_mask != 0); vif_idx++) {
+			if ((txq->stop_vif_mask & RS_BIT(vif_idx)) != 0) {
+				(void)rs_net_if_txq_stop(c_if, vif_idx, txq->sta_idx, FALSE);
+				txq->stop_vif_mask &= ~RS_BIT(vif_idx);
+			}
+		}
+
+		C_TX_SPIN_UNLOCK(c_if);
+	}
+}
+
+static u32 c_tx_isqrt(u32 value)
+{
+	u32 root = 0;
+	u32 bit = RS_BIT(30);
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+// next drop time, interval shrinks with square root of drop count
+static u32 c_tx_codel_control_law(u32 time_us, u32 count)
+{
+	u32 root = c_tx_isqrt(count);
+
+	return time_us + (C_TX_CODEL_INTERVAL_US / ((root > 0) ? root : 1));
+}
+
+static void c_tx_sojourn_hist_add(struct rs_c_if *c_if, u32 sojourn_us)
+{
+	u8 bucket = 0;
+
+	while ((sojourn_us != 0) && (bucket < (RS_C_TX_SOJOURN_HIST_MAX - 1))) {
+		sojourn_us >>= 1;
+		bucket++;
+	}
+
+	c_if->core->tx_data.sojourn_hist[bucket]++;
+}
+
+// CoDel dequeue decision of flow, TRUE if frame is to be dropped or marked
+static bool c_tx_codel_dequeue(struct rs_c_codel *codel, u32 sojourn_us, u32 now_us, u32 backlog)
+{
+	bool drop = FALSE;
+	bool ok_to_drop = FALSE;
+	u32 delta = 0;
+
+	// keep the link busy, last frame of queue is never dropped
+	if ((sojourn_us < C_TX_CODEL_TARGET_US) || (backlog == 0)) {
+		codel->first_above_us = 0;
+	} else if (codel->first_above_us == 0) {
+		// 0 is no time, keep bit 0 set
+		codel->first_above_us = (now_us + C_TX_CODEL_INTERVAL_US) | 1;
+	} else if (C_TX_TIME_AFTER_EQ(now_us, codel->first_above_us)) {
+		ok_to_drop = TRUE;
+	}
+
+	if (codel->dropping == TRUE) {
+		if (ok_to_drop == FALSE) {
+			codel->dropping = FALSE;
+		} else if (C_TX_TIME_AFTER_EQ(now_us, codel->drop_next_us)) {
+			drop = TRUE;
+			codel->count++;
+			codel->drop_next_us = c_tx_codel_control_law(codel->drop_next_us, codel->count);
+		}
+	} else if (ok_to_drop == TRUE) {
+		drop = TRUE;
+		codel->dropping = TRUE;
+
+		// re-entered soon after leaving, resume from previous drop rate
+		delta = codel->count - codel->last_count;
+		if ((delta > 1) &&
+		    !C_TX_TIME_AFTER_EQ(now_us, codel->drop_next_us + (16 * C_TX_CODEL_INTERVAL_US))) {
+			codel->count = delta;
+		} else {
+			codel->count = 1;
+		}
+		codel->last_count = codel->count;
+		codel->drop_next_us = c_tx_codel_control_law(now_us, codel->count);
+	}
+
+	return drop;
+}
+
+// AQM of popped data frame, returns TRUE if frame was dropped
+static bool c_tx_aqm_drop(struct rs_c_if *c_if, struct rs_c_q_buf *tx_buf, u32 now_us, u32 backlog)
+{
+	bool drop = FALSE;
+	u32 sojourn_us = now_us - tx_buf->enq_us;
+	struct rs_c_codel *codel = &c_if->core->tx_data.codel[tx_buf->flow_hash % RS_C_TX_CODEL_FLOW_MAX];
+
+	c_tx_sojourn_hist_add(c_if, sojourn_us);
+
+	if (sojourn_us >= C_TX_LIFETIME_US) {
+		c_if->core->tx_data.lifetime_drop++;
+		drop = TRUE;
+	} else if (c_tx_codel_dequeue(codel, sojourn_us, now_us, backlog) == TRUE) {
+		// ECN capable flow is marked instead
+		if (rs_net_skb_set_ce(tx_buf->data) == RS_SUCCESS) {
+			c_if->core->tx_data.codel_mark++;
+		} else {
+			c_if->core->tx_data.codel_drop++;
+			drop = TRUE;
+		}
+	}
+
+	if (drop == TRUE) {
+		RS_DBG("P:%s[%d]:drop:vif[%d]:sojourn[%u]\n", __func__, __LINE__, tx_buf->vif_idx,
+		       sojourn_us);
+		rs_net_tx_data_done(c_if, tx_buf->vif_idx, tx_buf->data);
+		(void)rs_net_skb_free(tx_buf->data);
+		tx_buf->data = NULL;
+	}
+
+	return drop;
+}
+
+// Arm safety timer for a kick that is deferred or waits for firmware
+static void c_tx_kick_defer(struct rs_c_if *c_if)
+{
+	rs_k_atomic_set_bit(C_TX_KICK_PENDING, &c_if->core->tx_data.kick_flags);
+	(void)rs_k_timer_start(&c_if->core->tx_data.kick_timer, C_TX_KICK_TIMEOUT_US);
+}
+
+// Firmware is off channel and its window is not over yet
+static bool c_tx_off_chan_held(struct rs_c_if *c_if)
+{
+	bool held = FALSE;
+
+	if ((c_if->core->tx_data.off_chan == TRUE) &&
+	    !C_TX_TIME_AFTER_EQ(rs_k_time_get_us(), c_if->core->tx_data.off_chan_until_us)) {
+		held = TRUE;
+	}
+
+	return held;
+}
+
+// Frames sent off channel would wait in firmware buffers, keep them queued here instead
+static bool c_tx_on_channel(struct rs_c_if *c_if)
+{
+	bool on_chan = TRUE;
+
+	if (c_if->core->tx_data.off_chan == TRUE) {
+		if (c_tx_off_chan_held(c_if) == FALSE) {
+			// return indication missed, window is over
+			c_if->core->tx_data.off_chan = FALSE;
+			c_if->core->tx_data.off_chan_expire_cnt++;
+		} else {
+			// return indication wakes TX thread, timer checks window meanwhile
+			on_chan = FALSE;
+			c_tx_kick_defer(c_if);
+		}
+	}
+
+	return on_chan;
+}
+
+static bool c_tx_can_send(struct rs_c_if *c_if, u8 ac, s32 *tx_avail_cnt)
+{
+	bool can_send = FALSE;
 
-			tx_data = NULL;
+	if (
+#ifdef C_TX_THREAD
+		(rs_k_thread_is_running() == RS_SUCCESS) &&
+#endif
+		(c_tx_on_channel(c_if) == TRUE)) {
+		// local credit, status is read from bus only when it runs out
+		*tx_avail_cnt = rs_c_status_tx_credit(c_if, ac);
+		if (*tx_avail_cnt == 0) {
+			*tx_avail_cnt = rs_c_status_tx_credit_refill(c_if, ac);
+		}
+
+		if (*tx_avail_cnt > 0) {
+			can_send = TRUE;
 		} else {
-			RS_DBG("P:%s[%d]:tx_data[%p]\n", __func__, __LINE__, tx_data);
+			// credit report wakes TX thread, timer retries if it never comes
+			c_tx_kick_defer(c_if);
+		}
+	}
+
+	return can_send;
+}
+
+// DRR visit of next backlogged queue in lane
+// returns sent frame count, RS_EMPTY if no queue of lane has backlog
+static s32 c_tx_lane_visit(struct rs_c_if *c_if, u8 lane, s32 tx_avail_cnt)
+{
+	s32 sent = RS_EMPTY;
+	struct rs_c_txq *txq = NULL;
+	struct rs_c_q_buf tx_buf;
+	s32 len = 0;
+	u32 first_idx = 0;
+	u32 used_idx = 0;
+	u32 batch = 0;
+	u32 count = 0;
+	u32 backlog = 0;
+	u32 i = 0;
+	u32 now_us = rs_k_time_get_us();
+	u16 member_num = (c_if->core->tx_data.txq_num / RS_C_TX_TID_MAX) * C_TX_LANE_TID_NUM;
+	u16 member = 0;
+	u16 n = 0;
+
+	for (n = 0; (n < member_num) && (sent == RS_EMPTY); n++) {
+		member = c_if->core->tx_data.lane_rr[lane];
+		c_if->core->tx_data.lane_rr[lane] = (member + 1) % member_num;
+
+		txq = c_tx_get_txq(c_if, member / C_TX_LANE_TID_NUM,
+				   c_tx_lane_tid[lane][member % C_TX_LANE_TID_NUM]);
+		if (!txq) {
+			continue;
+		}
+
+		batch = (tx_avail_cnt < C_TX_BATCH) ? tx_avail_cnt : C_TX_BATCH;
+
+		count = rs_c_ring_cons_n(&txq->ring, batch, &first_idx);
+		if (count == 0) {
+			txq->deficit = 0;
+			continue;
+		}
+
+		txq->deficit += C_TX_DRR_QUANTUM;
+		backlog = rs_c_ring_count(&txq->ring);
+
+		for (i = 0; i < count; i++) {
+			used_idx = RS_C_RING_IDX(&txq->ring, first_idx, i);
+
+			len = 0;
+			if (txq->buf[used_idx].data) {
+				len = rs_net_skb_get_data(txq->buf[used_idx].data, NULL);
+			}
+			if (len > txq->deficit) {
+				break;
+			}
+
+			tx_buf = txq->buf[used_idx];
+			txq->buf[used_idx].data = NULL;
+			txq->buf[used_idx].vif_idx = -1;
+
+			// dropped frame uses neither deficit nor firmware buffer
+			if (tx_buf.data && (c_tx_aqm_drop(c_if, &tx_buf, now_us, backlog - i - 1) == TRUE)) {
+				continue;
+			}
+
+			txq->deficit -= len;
+			if ((txq->amsdu_len > 0) && (c_if->core->tx_data.amsdu_num > 1) && tx_buf.data) {
+				c_tx_amsdu_add(c_if, txq, &tx_buf);
+			} else {
+				(void)c_tx_buf_send(c_if, IF_DATA_AC, &tx_buf);
+			}
+		}
+
+		// batch is bounded by credit, held frames go out before credit is looked at again
+		c_tx_amsdu_flush(c_if);
+		(void)c_tx_agg_flush(c_if);
+
+		rs_c_ring_cons_commit_n(&txq->ring, i);
+
+		if (rs_c_ring_empty(&txq->ring) == RS_EMPTY) {
+			txq->deficit = 0;
+		}
+
+		c_tx_txq_wake(c_if, txq);
+
+		sent = i;
+	}
+
+	return sent;
+}
+
+// Strict priority over access category lanes, DRR over (sta_idx, tid) queues in lane.
+// A lane passed over C_TX_STARVE_LIMIT times is served once ahead of higher lanes.
+static rs_ret c_tx_data_lane(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_SUCCESS;
+	s32 tx_avail_cnt = 0;
+	s32 sent = RS_EMPTY;
+	u8 served_lane = 0;
+	u8 lane = 0;
+
+	if (c_if->core->tx_data.txq && c_if->core->tx_data.txq_num > 0) {
+		while ((c_tx_data_pending(c_if) == TRUE) &&
+		       (c_tx_can_send(c_if, IF_DATA_AC, &tx_avail_cnt) == TRUE)) {
+			sent = RS_EMPTY;
+
+			// starvation protection
+			for (lane = 0; (lane < RS_C_TX_LANE_MAX) && (sent == RS_EMPTY); lane++) {
+				if (c_if->core->tx_data.lane_skip[lane] >= C_TX_STARVE_LIMIT) {
+					c_if->core->tx_data.lane_skip[lane] = 0;
+					sent = c_tx_lane_visit(c_if, lane, tx_avail_cnt);
+					if (sent != RS_EMPTY) {
+						c_if->core->tx_data.lane_starve[lane]++;
+						served_lane = lane;
+					}
+				}
+			}
+
+			// strict priority
+			for (lane = 0; (lane < RS_C_TX_LANE_MAX) && (sent == RS_EMPTY); lane++) {
+				sent = c_tx_lane_visit(c_if, lane, tx_avail_cnt);
+				if (sent == RS_EMPTY) {
+					c_if->core->tx_data.lane_skip[lane] = 0;
+				} else {
+					served_lane = lane;
+				}
+			}
+
+			if (sent == RS_EMPTY) {
+				break;
+			}
+
+			c_if->core->tx_data.lane_sent[served_lane] += sent;
+			for (lane = served_lane + 1; lane < RS_C_TX_LANE_MAX; lane++) {
+				c_if->core->tx_data.lane_skip[lane]++;
+			}
 		}
 	}
 
 	return ret;
 }
 
-static rs_ret c_tx_data(struct rs_c_if *c_if, u8 ac)
+static rs_ret c_tx_data_power(struct rs_c_if *c_if)
 {
 	rs_ret ret = RS_FAIL;
-	u8 *tx_skb = NULL;
-	u8 status = 0;
+	struct rs_c_q_buf tx_buf[C_TX_BATCH];
 	s32 tx_avail_cnt = 0;
-	s32 tx_cnt = 0;
-	s8 vif_idx = -1;
-	struct rs_q *temp_q = NULL;
-	struct rs_c_q_buf *temp_buf = NULL;
+	u32 batch = 0;
+	u32 count = 0;
+	u32 i = 0;
+
+	while ((rs_c_ring_empty(&c_if->core->tx_data.buf_power_q) != RS_EMPTY) &&
+	       (c_tx_can_send(c_if, IF_DATA_AC_POWER, &tx_avail_cnt) == TRUE)) {
+		// status is re-read per batch, never send more than firmware reported
+		batch = (tx_avail_cnt < C_TX_BATCH) ? tx_avail_cnt : C_TX_BATCH;
+
+		count = c_tx_pop_n(&c_if->core->tx_data.buf_power_q, c_if->core->tx_data.buf_power, tx_buf,
+				   batch);
+		if (count == 0) {
+			break;
+		}
+
+		for (i = 0; i < count; i++) {
+			ret = c_tx_buf_send(c_if, IF_DATA_AC_POWER, &tx_buf[i]);
+		}
+
+		(void)c_tx_agg_flush(c_if);
+	}
+
+	return ret;
+}
+
+static rs_ret c_tx_data(struct rs_c_if *c_if, u8 ac)
+{
+	rs_ret ret = RS_FAIL;
 
 	switch (ac) {
 	case IF_DATA_AC:
-		temp_q = &c_if->core->tx_data.buf_q;
-		temp_buf = c_if->core->tx_data.buf;
+		ret = c_tx_data_lane(c_if);
 		break;
 	case IF_DATA_AC_POWER:
-		temp_q = &c_if->core->tx_data.buf_power_q;
-		temp_buf = c_if->core->tx_data.buf_power;
+		ret = c_tx_data_power(c_if);
 		break;
 	default:
 		RS_DBG("P:%s[%d]:fail!!:ac[%d]\n", __func__, __LINE__, ac);
 		break;
 	}
 
-	tx_avail_cnt = rs_c_get_status_tx_avail_cnt(c_if, ac);
-
-	if ((temp_q) && (temp_buf)) {
-		while (
-#ifdef C_TX_THREAD
-			(rs_k_thread_is_running() == RS_SUCCESS) &&
-#endif
-			(rs_c_q_empty(temp_q) != RS_EMPTY) && (c_if->core->scan == 0) &&
-			((status = rs_c_get_status_tx(c_if, ac)) == 0) && (tx_cnt < tx_avail_cnt)) {
-			ret = c_tx_pop(c_if, ac, &vif_idx, &tx_skb);
-			if (tx_skb) {
-				if (rs_net_vif_idx_is_up(c_if, vif_idx) == RS_SUCCESS) {
-					ret = c_tx_data_send(c_if, tx_skb);
-				} else {
-					RS_DBG("P:%s[%d]:skip!!:vif[%d]\n", __func__, __LINE__, vif_idx);
-				}
-				(void)rs_net_skb_free(tx_skb);
-				tx_skb = NULL;
-			}
-			tx_cnt++;
+	return ret;
+}
 
-			if ((tx_cnt > 1) && ((tx_cnt % C_TX_BUFFER_THRESHOLD) == 0)) {
-				tx_avail_cnt = rs_c_get_status_tx_avail_cnt(c_if, ac);
-				tx_cnt = 0;
-			}
-		}
+static rs_ret c_tx_event_set(struct rs_c_if *c_if, rs_k_event_t event)
+{
+	rs_ret ret = RS_SUCCESS;
 
-		if (tx_skb) {
-			RS_DBG("P:%s[%d]:tx_skb memory leak!!:[%d]\n", __func__, __LINE__, ret);
-		}
+	// event post overwrites, keep power event pending
+	if ((rs_c_ring_empty(&(c_if->core->tx_data.buf_power_q)) != RS_EMPTY) &&
+	    (rs_c_status_tx_stalled(c_if, IF_DATA_AC_POWER) == FALSE) &&
+	    (c_tx_off_chan_held(c_if) == FALSE)) {
+		event |= RS_C_TX_POWER_EVENT;
+	}
 
-		if (vif_idx >= 0) {
-			// Start net_if
-			(void)rs_net_if_tx_stop(c_if, vif_idx, FALSE);
+#ifdef C_TX_THREAD
+	if (c_if->core->tx_data.event) {
+		if ((event & RS_C_TX_EVENT) != 0) {
+			ret = rs_k_event_post(c_if->core->tx_data.event, event);
 		}
 	}
+#else
+	if (event & RS_C_TX_POWER_EVENT) {
+		ret = rs_k_workqueue_add_work(c_if->core->wq, &(c_if->core->tx_data.power_work));
+	}
+	if (event & RS_C_TX_AC_EVENT) {
+		ret = rs_k_workqueue_add_work(c_if->core->wq, &(c_if->core->tx_data.work));
+	}
+#endif
 
 	return ret;
 }
 
+static rs_ret c_tx_kick(struct rs_c_if *c_if)
+{
+	rs_k_atomic_clear_bit(C_TX_KICK_PENDING, &c_if->core->tx_data.kick_flags);
+	c_if->core->tx_data.kick_cnt++;
+
+	return c_tx_event_set(c_if, RS_C_TX_AC_EVENT);
+}
+
+static void c_tx_kick_timer_handler(void *param)
+{
+	struct rs_c_if *c_if = param;
+
+	if (c_if && c_if->core &&
+	    (rs_k_atomic_test_and_clear_bit(C_TX_KICK_PENDING, &c_if->core->tx_data.kick_flags) == TRUE)) {
+		c_if->core->tx_data.kick_timer_cnt++;
+		// both lanes, a stalled power lane is retried as well
+		(void)c_tx_event_set(c_if, RS_C_TX_EVENT);
+	}
+}
+
 #ifdef C_TX_THREAD
 static s32 c_tx_thread(void *param)
 {
@@ -352,28 +1009,56 @@ static void c_tx_work_handler(void *param)
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
-rs_ret rs_c_tx_init(struct rs_c_if *c_if, u16 tx_buf_num, u16 tx_buf_power_num)
+rs_ret rs_c_tx_init(struct rs_c_if *c_if, u16 sta_num, u16 txq_depth, u16 tx_buf_power_num)
 {
 	rs_ret ret = RS_FAIL;
+	struct rs_c_txq *txq = NULL;
+	u16 txq_num = sta_num * RS_C_TX_TID_MAX;
+	u16 i = 0;
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
-	if (c_if && c_if->core && tx_buf_num > 0) {
+	if (c_if && c_if->core && txq_num > 0 && txq_depth > 0) {
 		C_TX_SPIN_LOCK_INIT(c_if);
 
-		c_if->core->tx_data.buf =
-			(struct rs_c_q_buf *)rs_k_calloc(tx_buf_num * sizeof(struct rs_c_q_buf));
-		if (c_if->core->tx_data.buf) {
+		ret = RS_SUCCESS;
+
+		c_if->core->tx_data.txq = (struct rs_c_txq *)rs_k_calloc(txq_num * sizeof(struct rs_c_txq));
+		if (c_if->core->tx_data.txq) {
+			c_if->core->tx_data.txq_num = txq_num;
+			c_if->core->tx_data.txq_depth = txq_depth;
+			c_if->core->tx_data.agg_frag_num = 1;
+
+			for (i = 0; (i < txq_num) && (ret == RS_SUCCESS); i++) {
+				txq = &c_if->core->tx_data.txq[i];
+				txq->sta_idx = i / RS_C_TX_TID_MAX;
+				txq->tid = i % RS_C_TX_TID_MAX;
+				txq->buf = (struct rs_c_q_buf *)rs_k_calloc(txq_depth *
+									    sizeof(struct rs_c_q_buf));
+				if (txq->buf) {
+					ret = rs_c_ring_init(&txq->ring, txq_depth);
+				} else {
+					ret = RS_MEMORY_FAIL;
+				}
+			}
+		} else {
+			ret = RS_MEMORY_FAIL;
+		}
+
+		if (ret == RS_SUCCESS) {
 			c_if->core->tx_data.buf_power = (struct rs_c_q_buf *)rs_k_calloc(
 				tx_buf_power_num * sizeof(struct rs_c_q_buf));
 		}
 
-		if (c_if->core->tx_data.buf && c_if->core->tx_data.buf_power) {
-			c_if->core->tx_data.buf_num = tx_buf_num;
-			ret = rs_c_q_init(&c_if->core->tx_data.buf_q, tx_buf_num);
-
+		if ((ret == RS_SUCCESS) && c_if->core->tx_data.buf_power) {
 			c_if->core->tx_data.buf_power_num = tx_buf_power_num;
-			ret = rs_c_q_init(&c_if->core->tx_data.buf_power_q, tx_buf_power_num);
+			ret = rs_c_ring_init(&c_if->core->tx_data.buf_power_q, tx_buf_power_num);
+
+			if (ret == RS_SUCCESS) {
+				// timer of jiffies would kick after 4 ms at HZ 250, 10 ms at HZ 100
+				ret = rs_k_timer_create_hr(&c_if->core->tx_data.kick_timer,
+							   c_tx_kick_timer_handler, c_if);
+			}
 
 #ifdef C_TX_THREAD
 			c_if->core->tx_data.event = rs_k_calloc(sizeof(struct rs_k_event));
@@ -391,8 +1076,7 @@ rs_ret rs_c_tx_init(struct rs_c_if *c_if, u16 tx_buf_num, u16 tx_buf_power_num)
 						       c_tx_power_work_handler, c_if);
 			ret = rs_k_workqueue_init_work(&(c_if->core->tx_data.work), c_tx_work_handler, c_if);
 #endif
-		} else {
-			c_if->core->tx_data.buf_num = 0;
+		} else if (ret == RS_SUCCESS) {
 			ret = RS_MEMORY_FAIL;
 		}
 	}
@@ -403,10 +1087,13 @@ rs_ret rs_c_tx_init(struct rs_c_if *c_if, u16 tx_buf_num, u16 tx_buf_power_num)
 rs_ret rs_c_tx_deinit(struct rs_c_if *c_if)
 {
 	rs_ret ret = RS_FAIL;
+	u16 i = 0;
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
 	if (c_if && c_if->core) {
+		(void)rs_k_timer_destroy(&c_if->core->tx_data.kick_timer);
+
 #ifdef C_TX_THREAD
 		(void)rs_k_event_post(c_if->core->tx_data.event, K_EVENT_EXIT);
 		ret = rs_k_thread_destroy(&c_if->core->tx_data.thread);
@@ -419,10 +1106,16 @@ rs_ret rs_c_tx_deinit(struct rs_c_if *c_if)
 		ret = c_tx_q_free(c_if);
 
 		// free buf
-		if (c_if->core->tx_data.buf) {
-			rs_k_free(c_if->core->tx_data.buf);
-			c_if->core->tx_data.buf = NULL;
-			c_if->core->tx_data.buf_num = 0;
+		if (c_if->core->tx_data.txq) {
+			for (i = 0; i < c_if->core->tx_data.txq_num; i++) {
+				if (c_if->core->tx_data.txq[i].buf) {
+					rs_k_free(c_if->core->tx_data.txq[i].buf);
+					c_if->core->tx_data.txq[i].buf = NULL;
+				}
+			}
+			rs_k_free(c_if->core->tx_data.txq);
+			c_if->core->tx_data.txq = NULL;
+			c_if->core->tx_data.txq_num = 0;
 		}
 
 		if (c_if->core->tx_data.buf_power) {
@@ -437,6 +1130,172 @@ rs_ret rs_c_tx_deinit(struct rs_c_if *c_if)
 	return ret;
 }
 
+// Get TX data queue of station, tid
+struct rs_c_txq *rs_c_tx_get_txq(struct rs_c_if *c_if, u8 sta_idx, u8 tid)
+{
+	return c_tx_get_txq(c_if, sta_idx, tid);
+}
+
+// Get queued data frame count of lane
+u32 rs_c_tx_lane_count(struct rs_c_if *c_if, u8 lane)
+{
+	u32 count = 0;
+	struct rs_c_txq *txq = NULL;
+	u16 sta_idx = 0;
+	u8 i = 0;
+
+	if (c_if && c_if->core && (lane < RS_C_TX_LANE_MAX)) {
+		for (sta_idx = 0; sta_idx < (c_if->core->tx_data.txq_num / RS_C_TX_TID_MAX); sta_idx++) {
+			for (i = 0; i < C_TX_LANE_TID_NUM; i++) {
+				txq = c_tx_get_txq(c_if, sta_idx, c_tx_lane_tid[lane][i]);
+				if (txq) {
+					count += rs_c_ring_count(&txq->ring);
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+// Get sojourn time percentile of data frames in microseconds, upper bound of histogram bucket
+u32 rs_c_tx_sojourn_pct(struct rs_c_if *c_if, u8 pct)
+{
+	u32 sojourn_us = 0;
+	u64 total = 0;
+	u64 sum = 0;
+	u8 bucket = 0;
+
+	if (c_if && c_if->core && (pct <= 100)) {
+		for (bucket = 0; bucket < RS_C_TX_SOJOURN_HIST_MAX; bucket++) {
+			total += c_if->core->tx_data.sojourn_hist[bucket];
+		}
+
+		for (bucket = 0; (bucket < RS_C_TX_SOJOURN_HIST_MAX) && (total > 0); bucket++) {
+			sum += c_if->core->tx_data.sojourn_hist[bucket];
+			if ((sum * 100) >= (total * pct)) {
+				sojourn_us = RS_BIT(bucket);
+				break;
+			}
+		}
+	}
+
+	return sojourn_us;
+}
+
+// Push data frame, TX thread is kicked at end of burst
+rs_ret rs_c_tx_data_post(struct rs_c_if *c_if, s8 vif_idx, u8 *tx_skb, bool more)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->core && tx_skb) {
+		ret = c_tx_push(c_if, IF_DATA_AC, vif_idx, tx_skb);
+
+		// failed frame is dropped, earlier frames of burst are still kicked at its end
+		if (more == TRUE) {
+			c_if->core->tx_data.kick_defer_cnt++;
+			c_tx_kick_defer(c_if);
+		} else {
+			(void)c_tx_kick(c_if);
+		}
+	}
+
+	return ret;
+}
+
+// Kick TX thread for deferred data frames
+rs_ret rs_c_tx_kick(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->core) {
+		ret = c_tx_kick(c_if);
+	}
+
+	return ret;
+}
+
+// Hold TX while firmware is off channel for up to window_us, 0 when back on channel
+rs_ret rs_c_tx_set_off_channel(struct rs_c_if *c_if, u32 window_us)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->core) {
+		if (window_us > 0) {
+			c_if->core->tx_data.off_chan_until_us = rs_k_time_get_us() + window_us;
+			c_if->core->tx_data.off_chan = TRUE;
+			c_if->core->tx_data.off_chan_cnt++;
+			ret = RS_SUCCESS;
+		} else {
+			// back on channel, drain what was held
+			c_if->core->tx_data.off_chan = FALSE;
+			(void)rs_c_tx_event_post(c_if, RS_IF_DATA_MAX, 0, NULL);
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
+rs_ret rs_c_tx_set_agg(struct rs_c_if *c_if, u32 agg_len, u32 agg_num)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->core) {
+		if (agg_len > RS_C_TX_AGG_LEN) {
+			agg_len = RS_C_TX_AGG_LEN;
+		}
+		if (agg_num > RS_C_TX_AGG_NUM_MAX) {
+			agg_num = RS_C_TX_AGG_NUM_MAX;
+		}
+
+		// aggregated write of one frame is plain write, so it is off below two
+		c_if->core->tx_data.agg_len = agg_len;
+		c_if->core->tx_data.agg_num = (agg_num > 1) ? agg_num : 0;
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+rs_ret rs_c_tx_set_amsdu(struct rs_c_if *c_if, u32 amsdu_len, u32 amsdu_num)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->core) {
+		if (amsdu_len > RS_C_TX_AMSDU_LEN) {
+			amsdu_len = RS_C_TX_AMSDU_LEN;
+		}
+		if (amsdu_num > RS_C_TX_AMSDU_NUM_MAX) {
+			amsdu_num = RS_C_TX_AMSDU_NUM_MAX;
+		}
+
+		// A-MSDU of one frame only adds subframe header, so it is off below two
+		c_if->core->tx_data.amsdu_len = amsdu_len;
+		c_if->core->tx_data.amsdu_num = (amsdu_num > 1) ? amsdu_num : 0;
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+rs_ret rs_c_tx_set_sta_amsdu(struct rs_c_if *c_if, u8 sta_idx, u16 amsdu_len)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_txq *txq = NULL;
+	u8 tid = 0;
+
+	for (tid = 0; tid < RS_C_TX_TID_MAX; tid++) {
+		txq = c_tx_get_txq(c_if, sta_idx, tid);
+		if (txq) {
+			txq->amsdu_len = amsdu_len;
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
 // Post tx_data event
 rs_ret rs_c_tx_event_post(struct rs_c_if *c_if, u8 ac, s8 vif_idx, u8 *tx_skb)
 {
@@ -448,28 +1307,16 @@ rs_ret rs_c_tx_event_post(struct rs_c_if *c_if, u8 ac, s8 vif_idx, u8 *tx_skb)
 			ret = c_tx_push(c_if, ac, vif_idx, tx_skb);
 		}
 
-		if (rs_c_q_empty(&(c_if->core->tx_data.buf_q)) != RS_EMPTY) {
+		if ((ret == RS_SUCCESS) && (ac == IF_DATA_AC)) {
+			event |= RS_C_TX_AC_EVENT;
+		} else if ((rs_c_status_tx_stalled(c_if, IF_DATA_AC) == FALSE) &&
+			   (c_tx_off_chan_held(c_if) == FALSE) && (c_tx_data_pending(c_if) == TRUE)) {
+			// stalled lane is woken by credit report and held one by return on channel or kick
+			// timer, neither is re-posted here
 			event |= RS_C_TX_AC_EVENT;
 		}
 
-		if (rs_c_q_empty(&(c_if->core->tx_data.buf_power_q)) != RS_EMPTY) {
-			event |= RS_C_TX_POWER_EVENT;
-		}
-
-#ifdef C_TX_THREAD
-		if (c_if->core->tx_data.event) {
-			if ((event & RS_C_TX_EVENT) != 0) {
-				(void)rs_k_event_post(c_if->core->tx_data.event, event);
-			}
-		}
-#else
-		if (event & RS_C_TX_POWER_EVENT) {
-			ret = rs_k_workqueue_add_work(c_if->core->wq, &(c_if->core->tx_data.power_work));
-		}
-		if (event & RS_C_TX_AC_EVENT) {
-			ret = rs_k_workqueue_add_work(c_if->core->wq, &(c_if->core->tx_data.work));
-		}
-#endif
+		(void)c_tx_event_set(c_if, event);
 	}
 
 	return ret;
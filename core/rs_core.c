@@ -20,6 +20,7 @@
 #include "rs_c_tx.h"
 #include "rs_c_recovery.h"
 #include "rs_net.h"
+#include "rs_net_skb.h"
 
 #include "rs_core.h"
 
@@ -29,14 +30,27 @@
 #define C_STATUS_INIT(c_if)   (void)rs_k_mutex_create(&c_if->core->status.mutex)
 #define C_STATUS_DEINIT(c_if) (void)rs_k_mutex_destroy(&c_if->core->status.mutex)
 
+// RX buffers out of queues: one being read, popped batches of RX data and indication consumers
+#define C_RX_POOL_SPARE	      (32)
+#define C_RX_POOL_NUM	      (RS_NET_RX_BUF_Q_MAX + RS_NET_INID_BUF_Q_MAX + C_RX_POOL_SPARE)
+#define C_RX_POOL_LOW_MARK    (C_RX_POOL_NUM / 8)
+#define C_RX_POOL_MAX	      (C_RX_POOL_NUM * 2)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
 
-struct rs_c_dbg_stat_t rs_c_dbg_stat = {
-	0,
+struct rs_c_dbg_stat_t *rs_c_dbg_stat = NULL;
+
+// cores sharing rs_c_dbg_stat, probe and remove of devices do not run at once
+static u32 c_dbg_stat_users;
+
+// RX data buffers become sk_buff heads, network layer allocates them
+static const struct rs_c_pool_ops c_rx_pool_ops = {
+	.alloc = rs_net_skb_rx_buf_alloc,
+	.free = rs_net_skb_rx_buf_free,
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +62,11 @@ static rs_ret core_init(struct rs_c_if *c_if)
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
+	if (c_dbg_stat_users == 0) {
+		rs_c_dbg_stat = rs_k_percpu_calloc(sizeof(struct rs_c_dbg_stat_t));
+	}
+	c_dbg_stat_users++;
+
 	c_if->core->wq = rs_k_calloc(sizeof(struct rs_k_workqueue));
 	if (!c_if->core->wq) {
 		RS_ERR("Failed to allocate workqueue");
@@ -72,6 +91,13 @@ static rs_ret core_init(struct rs_c_if *c_if)
 		return ret;
 	}
 
+	ret = rs_c_pool_init(&c_if->core->rx_pool, RS_C_RX_BUF_SIZE, C_RX_POOL_NUM,
+			     C_RX_POOL_LOW_MARK, C_RX_POOL_MAX, &c_rx_pool_ops);
+	if (ret != RS_SUCCESS) {
+		RS_ERR("Failed to initialize RX buffer pool, ret=%d", ret);
+		return ret;
+	}
+
 	ret = rs_c_indi_init(c_if, RS_NET_INID_BUF_Q_MAX);
 	if (ret != RS_SUCCESS) {
 		RS_ERR("Failed to initialize indication module, ret=%d", ret);
@@ -90,7 +116,7 @@ static rs_ret core_init(struct rs_c_if *c_if)
 		return ret;
 	}
 
-	ret = rs_c_tx_init(c_if, RS_NET_TX_BUF_Q_MAX, RS_NET_TX_POWER_BUF_Q_MAX);
+	ret = rs_c_tx_init(c_if, RS_NET_TXQ_STA_MAX, RS_NET_TXQ_BUF_Q_MAX, RS_NET_TX_POWER_BUF_Q_MAX);
 	if (ret != RS_SUCCESS) {
 		RS_ERR("Failed to initialize TX module, ret=%d", ret);
 		return ret;
@@ -138,12 +164,20 @@ static rs_ret core_deinit(struct rs_c_if *c_if)
 
 	(void)rs_c_indi_deinit(c_if);
 
+	(void)rs_c_pool_deinit(&c_if->core->rx_pool);
+
 	(void)rs_c_recovery_deinit(c_if);
 
 	(void)rs_c_ctrl_deinit(c_if);
 
 	(void)rs_c_status_deinit(c_if);
 
+	c_dbg_stat_users--;
+	if ((c_dbg_stat_users == 0) && rs_c_dbg_stat) {
+		rs_k_percpu_free(rs_c_dbg_stat);
+		rs_c_dbg_stat = NULL;
+	}
+
 	return ret;
 }
 
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+#ifndef RS_K_ATOMIC_H
+#define RS_K_ATOMIC_H
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Load value with acquire ordering
+u32 rs_k_atomic_load_acquire(const u32 *ptr);
+
+// Store value with release ordering
+void rs_k_atomic_store_release(u32 *ptr, u32 value);
+
+// Add to value, returns new value
+u32 rs_k_atomic_add_return(u32 *ptr, s32 value);
+
+// Load pointer once, no tearing or compiler reuse
+void *rs_k_atomic_load_ptr(void **ptr);
+
+// Compare and exchange pointer with full ordering, returns pointer found
+void *rs_k_atomic_cmpxchg_ptr(void **ptr, void *old_value, void *new_value);
+
+// Set bit nr of flags
+void rs_k_atomic_set_bit(u32 nr, unsigned long *flags);
+
+// Clear bit nr of flags
+void rs_k_atomic_clear_bit(u32 nr, unsigned long *flags);
+
+// Test bit nr of flags
+bool rs_k_atomic_test_bit(u32 nr, const unsigned long *flags);
+
+// Set bit nr of flags with full ordering, returns TRUE if it was set
+bool rs_k_atomic_test_and_set_bit(u32 nr, unsigned long *flags);
+
+// Clear bit nr of flags with full ordering, returns TRUE if it was set
+bool rs_k_atomic_test_and_clear_bit(u32 nr, unsigned long *flags);
+
+#endif /* RS_K_ATOMIC_H */
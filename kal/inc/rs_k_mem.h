@@ -48,4 +48,19 @@ s32 rs_k_memcmp(const void *cs, const void *ct, u32 len);
 // memory set
 void *rs_k_memset(void *s, int c, u32 count);
 
+// memory bus may DMA to or from, FALSE for vmalloc, module image and stack memory
+bool rs_k_mem_dma_safe(const void *ptr);
+
+// allocates memory of every CPU initialized 0, only rs_k_percpu_* access it
+void *rs_k_percpu_calloc(u32 size);
+
+// frees memory of rs_k_percpu_calloc
+void rs_k_percpu_free(void *pcpu);
+
+// adds to counter of this CPU, cnt points into rs_k_percpu_calloc memory
+void rs_k_percpu_add(u32 *cnt, u32 val);
+
+// sums counter of every CPU
+u32 rs_k_percpu_sum(u32 *cnt);
+
 #endif /* RS_K_MEM_H */
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+#ifndef RS_K_TIMER_H
+#define RS_K_TIMER_H
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+struct rs_k_timer {
+	void *timer;
+};
+
+// called in atomic context
+typedef void(rs_k_timer_cb)(void *);
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Create one-shot timer
+rs_ret rs_k_timer_create(struct rs_k_timer *k_timer, rs_k_timer_cb *cb_func, void *arg);
+
+// Create one-shot high resolution timer, it fires in usec where one above waits whole jiffies
+rs_ret rs_k_timer_create_hr(struct rs_k_timer *k_timer, rs_k_timer_cb *cb_func, void *arg);
+
+// Destroy timer, waits running callback
+rs_ret rs_k_timer_destroy(struct rs_k_timer *k_timer);
+
+// Start timer if not pending, RS_BUSY if already pending
+rs_ret rs_k_timer_start(struct rs_k_timer *k_timer, u32 usec);
+
+#endif /* RS_K_TIMER_H */
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include <linux/compiler.h>
+#include <linux/atomic.h>
+#include <linux/bitops.h>
+#include <asm/barrier.h>
+
+#include "rs_type.h"
+
+#include "rs_k_atomic.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Load value with acquire ordering
+u32 rs_k_atomic_load_acquire(const u32 *ptr)
+{
+	u32 value = 0;
+
+	if (ptr) {
+		value = smp_load_acquire(ptr);
+	}
+
+	return value;
+}
+
+// Store value with release ordering
+void rs_k_atomic_store_release(u32 *ptr, u32 value)
+{
+	if (ptr) {
+		smp_store_release(ptr, value);
+	}
+}
+
+// Add to value, returns new value
+u32 rs_k_atomic_add_return(u32 *ptr, s32 value)
+{
+	u32 old_value = 0;
+	u32 new_value = 0;
+
+	if (ptr) {
+		do {
+			old_value = READ_ONCE(*ptr);
+			new_value = old_value + value;
+		} while (cmpxchg(ptr, old_value, new_value) != old_value);
+	}
+
+	return new_value;
+}
+
+// Load pointer once, no tearing or compiler reuse
+void *rs_k_atomic_load_ptr(void **ptr)
+{
+	void *value = NULL;
+
+	if (ptr) {
+		value = READ_ONCE(*ptr);
+	}
+
+	return value;
+}
+
+// Compare and exchange pointer with full ordering, returns pointer found
+void *rs_k_atomic_cmpxchg_ptr(void **ptr, void *old_value, void *new_value)
+{
+	void *value = NULL;
+
+	if (ptr) {
+		value = cmpxchg(ptr, old_value, new_value);
+	}
+
+	return value;
+}
+
+// Set bit nr of flags
+void rs_k_atomic_set_bit(u32 nr, unsigned long *flags)
+{
+	if (flags) {
+		set_bit(nr, flags);
+	}
+}
+
+// Clear bit nr of flags
+void rs_k_atomic_clear_bit(u32 nr, unsigned long *flags)
+{
+	if (flags) {
+		clear_bit(nr, flags);
+	}
+}
+
+// Test bit nr of flags
+bool rs_k_atomic_test_bit(u32 nr, const unsigned long *flags)
+{
+	bool set = FALSE;
+
+	if (flags) {
+		set = test_bit(nr, flags) ? TRUE : FALSE;
+	}
+
+	return set;
+}
+
+// Set bit nr of flags with full ordering, returns TRUE if it was set
+bool rs_k_atomic_test_and_set_bit(u32 nr, unsigned long *flags)
+{
+	bool set = FALSE;
+
+	if (flags) {
+		set = test_and_set_bit(nr, flags) ? TRUE : FALSE;
+	}
+
+	return set;
+}
+
+// Clear bit nr of flags with full ordering, returns TRUE if it was set
+bool rs_k_atomic_test_and_clear_bit(u32 nr, unsigned long *flags)
+{
+	bool set = FALSE;
+
+	if (flags) {
+		set = test_and_clear_bit(nr, flags) ? TRUE : FALSE;
+	}
+
+	return set;
+}
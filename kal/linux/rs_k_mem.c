@@ -9,6 +9,9 @@
 
 #include <linux/string.h>
 #include <linux/slab.h>
+#include <linux/mm.h>
+#include <linux/sched/task_stack.h>
+#include <linux/percpu.h>
 
 #include "rs_type.h"
 
@@ -71,6 +74,44 @@ void *rs_k_memset(void *s, int c, u32 count)
 	return memset(s, c, count);
 }
 
+bool rs_k_mem_dma_safe(const void *ptr)
+{
+	bool safe = FALSE;
+
+	if (ptr && virt_addr_valid(ptr) && !is_vmalloc_addr(ptr) && !object_is_on_stack(ptr)) {
+		safe = TRUE;
+	}
+
+	return safe;
+}
+
+void *rs_k_percpu_calloc(u32 size)
+{
+	return (void __force *)__alloc_percpu(size, sizeof(u64));
+}
+
+void rs_k_percpu_free(void *pcpu)
+{
+	free_percpu((void __percpu __force *)pcpu);
+}
+
+void rs_k_percpu_add(u32 *cnt, u32 val)
+{
+	this_cpu_add(*(u32 __percpu __force *)cnt, val);
+}
+
+u32 rs_k_percpu_sum(u32 *cnt)
+{
+	u32 sum = 0;
+	int cpu = 0;
+
+	for_each_possible_cpu(cpu) {
+		sum += *per_cpu_ptr((u32 __percpu __force *)cnt, cpu);
+	}
+
+	return sum;
+}
+
 #ifndef CONFIG_RS_COMBINE_DRIVER
 EXPORT_SYMBOL(rs_k_malloc);
 EXPORT_SYMBOL(rs_k_calloc);
@@ -80,4 +121,9 @@ EXPORT_SYMBOL(rs_k_free);
 EXPORT_SYMBOL(rs_k_memcpy);
 EXPORT_SYMBOL(rs_k_memcmp);
 EXPORT_SYMBOL(rs_k_memset);
+EXPORT_SYMBOL(rs_k_mem_dma_safe);
+EXPORT_SYMBOL(rs_k_percpu_calloc);
+EXPORT_SYMBOL(rs_k_percpu_free);
+EXPORT_SYMBOL(rs_k_percpu_add);
+EXPORT_SYMBOL(rs_k_percpu_sum);
 #endif
\ No newline at end of file
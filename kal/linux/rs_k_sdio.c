@@ -60,6 +60,9 @@
 
 #define SDIO_MAX_BLOCK_CNT		  (5)
 
+// gather buffer of fragmented frame or aggregated write, block padding is written from it too
+#define SDIO_TX_BUFF_LEN		  RS_C_TX_AGG_LEN
+
 #define RS_SDIO_GET_CNT(len, blk_size)	  (((u32)(len)) / (blk_size))
 #define RS_SDIO_GET_REMAIN(len, blk_size) (((u32)(len)) % (blk_size))
 
@@ -83,6 +86,9 @@ struct reg_n_addr {
 struct sdio_dev_if_priv {
 	struct rs_k_mutex mutex;
 	bool suspend;
+
+	// under mutex
+	u8 *tx_buff;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -356,9 +362,25 @@ static rs_ret k_sdio_read(struct rs_c_if *c_if, u32 addr, u8 *data, u32 len)
 		// RS_DBG("P:%s:err[%d]:c_if[%p]:dev[%p]:cnt[%d]:remain[%d]:i[%d]:rx_buf_pos[%d]\n", __func__,
 		//        err, c_if, c_if->if_dev.dev, cnt, remain, i, rx_buf_pos);
 #else
-		temp_len += ALIGN_512BYTE(len); // 4 byte align
+		// header block first, then only rest of frame rounded up to block
+		err = sdio_readsb(func, data, 0, SDIO_BLOCK_SIZE); // auto incre
+		if (err == 0) {
+			temp_len += ALIGN_512BYTE(len);
+			if (RS_C_IS_CMD(((struct rs_c_data *)data)->cmd)) {
+				temp_len = RS_C_GET_DATA_SIZE(((struct rs_c_data *)data)->ext_len,
+							      ((struct rs_c_data *)data)->data_len);
+				temp_len += ALIGN_512BYTE(temp_len);
+			}
+			if ((u32)temp_len > len) {
+				RS_ERR("sdio read len[%d][%d] !!!\n", temp_len, len);
+				temp_len = len;
+			}
 
-		err = sdio_readsb(func, data, 0, temp_len); // auto incre
+			if (temp_len > SDIO_BLOCK_SIZE) {
+				err = sdio_readsb(func, data + SDIO_BLOCK_SIZE, 0,
+						  temp_len - SDIO_BLOCK_SIZE);
+			}
+		}
 		if (err != 0) {
 			RS_ERR("sdio_readsb err %d !!!\n", err);
 		}
@@ -444,6 +466,204 @@ static rs_ret k_sdio_write(struct rs_c_if *c_if, u32 addr, u8 *data, u32 len)
 	return ret;
 }
 
+#if defined(RRQ61000_BA_MULTI_BLOCK_RX) || defined(RRQ61000_BA_MULTI_BLOCK_TX)
+// Segments but last one are whole blocks, each can go in CMD53 of its own to same FIFO address
+// Host may DMA from segment, so one in vmalloc or module memory (e.g. static padding) is gathered
+static bool k_sdio_frag_aligned(struct rs_c_if_frag *frag, u8 frag_num)
+{
+	bool aligned = TRUE;
+	u8 i = 0;
+
+	for (i = 0; i < frag_num; i++) {
+		if (((i + 1) < frag_num) &&
+		    ((frag[i].len == 0) || (RS_SDIO_GET_REMAIN(frag[i].len, SDIO_BLOCK_SIZE) != 0))) {
+			aligned = FALSE;
+		}
+		if (rs_k_mem_dma_safe(frag[i].data) == FALSE) {
+			aligned = FALSE;
+		}
+	}
+
+	return aligned;
+}
+#endif
+
+#ifdef RRQ61000_BA_MULTI_BLOCK_RX
+// Header block into first segment, then only rest of frame rounded up to block over the others
+static rs_ret k_sdio_readv_blocks(struct rs_c_if *c_if, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+	s32 err = 0;
+	struct sdio_func *func = NULL;
+	struct rs_c_data *head = NULL;
+	u32 len = 0;
+	u32 frame_len = 0;
+	u32 pos = 0;
+	u32 off = 0;
+	u32 rd_len = 0;
+	u8 i = 0;
+
+	for (i = 0; i < frag_num; i++) {
+		len += frag[i].len;
+	}
+
+	func = rs_c_if_get_dev(c_if);
+	if (c_if && func) {
+		func->num = 1;
+
+		sdio_claim_host(func);
+
+		err = sdio_readsb(func, frag[0].data, 0, SDIO_BLOCK_SIZE);
+		if (err == 0) {
+			head = (struct rs_c_data *)frag[0].data;
+			frame_len = len;
+			if (RS_C_IS_CMD(head->cmd)) {
+				frame_len = RS_C_GET_DATA_SIZE(head->ext_len, head->data_len);
+				frame_len += ALIGN_512BYTE(frame_len);
+			}
+			if (frame_len > len) {
+				RS_ERR("sdio read len[%d][%d] !!!\n", frame_len, len);
+				frame_len = len;
+			}
+
+			pos = SDIO_BLOCK_SIZE;
+			for (i = 0; (i < frag_num) && (pos < frame_len) && (err == 0); i++) {
+				off = (i == 0) ? SDIO_BLOCK_SIZE : 0;
+				rd_len = frag[i].len - off;
+				if (rd_len > (frame_len - pos)) {
+					rd_len = frame_len - pos;
+				}
+				if (rd_len > 0) {
+					err = sdio_readsb(func, frag[i].data + off, 0, rd_len);
+					pos += rd_len;
+				}
+			}
+		}
+		if (err != 0) {
+			RS_ERR("sdio_readsb err %d !!!\n", err);
+		}
+
+		sdio_release_host(func);
+
+		if (err == 0) {
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+#endif
+
+#ifdef RRQ61000_BA_MULTI_BLOCK_TX
+// Segments are written as they are, only tail of last one is padded to block in gather buffer
+// under mutex
+static rs_ret k_sdio_writev_blocks(struct rs_c_if *c_if, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+	s32 err = 0;
+	struct sdio_func *func = NULL;
+	struct sdio_dev_if_priv *dev_if_priv = c_if->if_dev.dev_if_priv;
+	struct rs_c_if_frag *last = &frag[frag_num - 1];
+	u32 tail = RS_SDIO_GET_REMAIN(last->len, SDIO_BLOCK_SIZE);
+	u8 i = 0;
+
+	func = rs_c_if_get_dev(c_if);
+	if (func && (dev_if_priv->tx_buff != NULL)) {
+		func->num = 1;
+
+		sdio_claim_host(func);
+
+		for (i = 0; ((i + 1) < frag_num) && (err == 0); i++) {
+			err = sdio_writesb(func, 0, frag[i].data, frag[i].len);
+		}
+		if ((err == 0) && (last->len > tail)) {
+			err = sdio_writesb(func, 0, last->data, last->len - tail);
+		}
+		if ((err == 0) && (tail > 0)) {
+			(void)rs_k_memcpy(dev_if_priv->tx_buff, last->data + last->len - tail, tail);
+			err = sdio_writesb(func, 0, dev_if_priv->tx_buff, tail + ALIGN_512BYTE(tail));
+		}
+		if (err != 0) {
+			RS_ERR("sdio_writesb err %d !!!\n", err);
+		}
+
+		sdio_release_host(func);
+
+		if (err == 0) {
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+#endif
+
+// Segments not fitting CMD53 sequence go through generic flat read
+static rs_ret k_sdio_readv(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_NOT_SUPPORT;
+
+	if (frag_num == 1) {
+		ret = k_sdio_read(c_if, addr, frag[0].data, frag[0].len);
+#ifdef RRQ61000_BA_MULTI_BLOCK_RX
+	} else if (k_sdio_frag_aligned(frag, frag_num) == TRUE) {
+		ret = k_sdio_readv_blocks(c_if, frag, frag_num);
+#endif
+	}
+
+	return ret;
+}
+
+// SDIO function API takes one buffer per transfer, segments are gathered into it under mutex
+static rs_ret k_sdio_writev_gather(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+	struct sdio_dev_if_priv *dev_if_priv = c_if->if_dev.dev_if_priv;
+	u32 len = 0;
+	u8 i = 0;
+
+	for (i = 0; (i < frag_num) && (dev_if_priv->tx_buff != NULL); i++) {
+		if ((len + frag[i].len) > SDIO_TX_BUFF_LEN) {
+			RS_ERR("sdio frag len[%d][%d] !!!\n", len, frag[i].len);
+			len = 0;
+			break;
+		}
+
+		(void)rs_k_memcpy(dev_if_priv->tx_buff + len, frag[i].data, frag[i].len);
+		len += frag[i].len;
+	}
+
+	if (len > 0) {
+		ret = k_sdio_write(c_if, addr, dev_if_priv->tx_buff, len);
+	}
+
+	return ret;
+}
+
+// Block aligned segments go in CMD53 sequence, others are gathered
+static rs_ret k_sdio_writev(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+
+	if (c_if && c_if->if_dev.dev_if_priv) {
+		C_IF_DEV_MUTEX_LOCK(c_if);
+
+		ret = RS_NOT_SUPPORT;
+#ifdef RRQ61000_BA_MULTI_BLOCK_TX
+		if (k_sdio_frag_aligned(frag, frag_num) == TRUE) {
+			ret = k_sdio_writev_blocks(c_if, frag, frag_num);
+		}
+#endif
+		if (ret == RS_NOT_SUPPORT) {
+			ret = k_sdio_writev_gather(c_if, addr, frag, frag_num);
+		}
+
+		C_IF_DEV_MUTEX_UNLOCK(c_if);
+	}
+
+	return ret;
+}
+
 static rs_ret k_sdio_read_status(struct rs_c_if *c_if, u8 *data, u32 len)
 {
 	rs_ret ret = RS_FAIL;
@@ -472,6 +692,22 @@ static rs_ret k_sdio_read_status(struct rs_c_if *c_if, u8 *data, u32 len)
 	return ret;
 }
 
+// Segments go natively in CMD53 sequence when all but last one are whole blocks
+static rs_ret k_sdio_bus_capa(struct rs_c_if *c_if, struct rs_c_if_bus_capa *capa)
+{
+	capa->flags = 0;
+#ifdef RRQ61000_BA_MULTI_BLOCK_RX
+	capa->flags |= RS_C_IF_BUS_READV;
+#endif
+#ifdef RRQ61000_BA_MULTI_BLOCK_TX
+	capa->flags |= RS_C_IF_BUS_WRITEV;
+#endif
+	capa->seg_max = RS_C_IF_FRAG_MAX;
+	capa->seg_align = SDIO_BLOCK_SIZE;
+
+	return RS_SUCCESS;
+}
+
 static rs_ret k_sdio_reload(struct rs_c_if *c_if)
 {
 	rs_ret ret = RS_FAIL;
@@ -713,6 +949,7 @@ static void k_sdio_host_reset(struct sdio_func *func)
 static void k_sdio_rrq61000_remove(struct sdio_func *func)
 {
 	struct rs_c_if *c_if = sdio_get_drvdata(func);
+	struct sdio_dev_if_priv *dev_if_priv = NULL;
 
 	RS_DBG(RS_FN_ENTRY_STR_ ":c_if[0x%p]\n", __func__, c_if);
 
@@ -731,12 +968,21 @@ static void k_sdio_rrq61000_remove(struct sdio_func *func)
 		(void)rs_c_if_set_dev_if(c_if, NULL);
 		c_if->if_ops.read = NULL;
 		c_if->if_ops.write = NULL;
+		c_if->if_ops.readv = NULL;
+		c_if->if_ops.writev = NULL;
+		c_if->if_ops.bus_capa = NULL;
 		c_if->if_ops.read_status = NULL;
 		c_if->if_ops.reload = NULL;
 
 		if (c_if->if_dev.dev_if_priv != NULL) {
 			C_IF_DEV_MUTEX_DEINIT(c_if);
 
+			dev_if_priv = c_if->if_dev.dev_if_priv;
+			if (dev_if_priv->tx_buff) {
+				rs_k_free(dev_if_priv->tx_buff);
+				dev_if_priv->tx_buff = NULL;
+			}
+
 			rs_k_free(c_if->if_dev.dev_if_priv);
 			c_if->if_dev.dev_if_priv = NULL;
 		}
@@ -772,7 +1018,12 @@ static rs_ret k_sdio_rrq61000_probe(struct sdio_func *func, const struct sdio_de
 				c_if->if_dev.dev_if_priv = dev_if_priv;
 				C_IF_DEV_MUTEX_INIT(c_if);
 
-				ret = RS_SUCCESS;
+				dev_if_priv->tx_buff = rs_k_calloc(SDIO_TX_BUFF_LEN + SDIO_BLOCK_SIZE);
+				if (dev_if_priv->tx_buff != NULL) {
+					ret = RS_SUCCESS;
+				} else {
+					ret = RS_MEMORY_FAIL;
+				}
 			} else {
 				ret = RS_MEMORY_FAIL;
 			}
@@ -784,6 +1035,9 @@ static rs_ret k_sdio_rrq61000_probe(struct sdio_func *func, const struct sdio_de
 				(void)rs_c_if_set_dev_if(c_if, (void *)&func->dev);
 				c_if->if_ops.read = k_sdio_read;
 				c_if->if_ops.write = k_sdio_write;
+				c_if->if_ops.readv = k_sdio_readv;
+				c_if->if_ops.writev = k_sdio_writev;
+				c_if->if_ops.bus_capa = k_sdio_bus_capa;
 				c_if->if_ops.read_status = k_sdio_read_status;
 				c_if->if_ops.reload = k_sdio_reload;
 
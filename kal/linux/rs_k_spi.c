@@ -15,6 +15,8 @@
 #include <linux/delay.h>
 #include <linux/of_gpio.h>
 #include <linux/interrupt.h>
+#include <linux/completion.h>
+#include <linux/ktime.h>
 
 #include "rs_type.h"
 #include "rs_k_mem.h"
@@ -23,6 +25,7 @@
 #include "rs_c_cmd.h"
 #include "rs_c_data.h"
 #include "rs_c_if.h"
+#include "rs_c_rx.h"
 #include "rs_k_spi.h"
 #include "rs_k_if.h"
 #include "rs_core.h"
@@ -46,6 +49,16 @@
 #define RRQ61000_FW_PROTOCOL_SIZE 12 // preamble[2], length[4], image_crc[4], spi_mode[1] , crc[1] = 12 byte
 #define RRQ61000_FW_RECEIVE_SIZE  4
 
+#define SPI_ALIGN_4(len)	  ((((len) + 3) / 4) * 4)
+
+// state GPIO handshake, spinning longer than sleep and wake up take does not pay back
+#define SPI_STATE_SPIN_MAX_US	  (20)
+// handshake latency average is kept scaled by 8
+#define SPI_STATE_AVG_SHIFT	  (3)
+
+// RX frame is read in two phases, IF header and RX ext header first
+#define SPI_RX_HEAD_LEN		  SPI_ALIGN_4(RS_C_GET_DATA_SIZE(RS_C_RX_EXT_LEN, 0))
+
 #define C_IF_DEV_MUTEX_INIT(c_if) \
 	(void)rs_k_mutex_create(&(((struct spi_dev_if_priv *)((c_if)->if_dev.dev_if_priv))->mutex))
 #define C_IF_DEV_MUTEX_DEINIT(c_if) \
@@ -69,12 +82,22 @@ struct spi_dev_if_priv {
 	u8 *rx_buff;
 	u8 *tx_buff;
 
+	// fragments of one frame and word padding, under mutex
+	struct spi_transfer frag_tr[RS_C_IF_FRAG_MAX + 1];
+
 	s32 gpio_reset;
 	s32 gpio_irq;
 	s32 gpio_irq_nb;
 #ifdef 	USE_GPIO_STATE
 	s32 gpio_irq_state;
 	s32 gpio_irq_state_nb;
+
+	// completed by state GPIO IRQ, latency counts from start of bus phase
+	struct completion state_done;
+	ktime_t state_start;
+	ktime_t state_at;
+	u32 state_lat_avg;
+	struct rs_c_if_hs_stats hs_stats;
 #endif	
 };
 
@@ -85,9 +108,6 @@ struct k_spi_header {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
-#if USE_GPIO_STATE
-static unsigned int	state_change_flag = 1;
-#endif
 // static unsigned long prev_xfer_time; // = jiffies;
 
 static const u32 crc32_tab[] = {
@@ -165,27 +185,87 @@ irqreturn_t rs_irq_handler(s32 irq, void *dev_id)
 #if USE_GPIO_STATE
 irqreturn_t rs_irq_handler_state(s32 irq, void *dev_id)
 {
-	state_change_flag = 1;
+	struct rs_c_if *c_if = (struct rs_c_if *)dev_id;
+	struct spi_dev_if_priv *dev_if_priv = c_if->if_dev.dev_if_priv;
+
+	dev_if_priv->state_at = ktime_get();
+	complete(&dev_if_priv->state_done);
 
 	return IRQ_HANDLED;
 }
 
-static void k_spi_reset_state_change(void)
+static void k_spi_reset_state_change(struct spi_dev_if_priv *dev_if_priv)
 {
-	state_change_flag = 0;
+	reinit_completion(&dev_if_priv->state_done);
+	dev_if_priv->state_start = ktime_get();
 }
 
-static rs_ret k_spi_wait_state_change(u32 timeout_us)
+// Spin only while handshake usually comes sooner than sleeping would wake up
+static u32 k_spi_state_spin_us(struct spi_dev_if_priv *dev_if_priv)
 {
-	rs_ret ret = RS_FAIL;
+	u32 avg_us = dev_if_priv->state_lat_avg >> SPI_STATE_AVG_SHIFT;
+	u32 spin_us = 0;
+
+	if (avg_us <= SPI_STATE_SPIN_MAX_US) {
+		spin_us = (avg_us * 2) + 1;
+		if (spin_us > SPI_STATE_SPIN_MAX_US) {
+			spin_us = SPI_STATE_SPIN_MAX_US;
+		}
+	}
 
-	for(int i = 0; i < timeout_us / 10; i++) {
-		if(state_change_flag) {
+	return spin_us;
+}
+
+static void k_spi_state_stats(struct spi_dev_if_priv *dev_if_priv, u32 lat_us)
+{
+	struct rs_c_if_hs_stats *hs_stats = &dev_if_priv->hs_stats;
+	u32 idx = fls(lat_us);
+
+	if (idx >= RS_C_IF_HS_HIST_NUM) {
+		idx = RS_C_IF_HS_HIST_NUM - 1;
+	}
+	hs_stats->hist[idx]++;
+
+	dev_if_priv->state_lat_avg += lat_us - (dev_if_priv->state_lat_avg >> SPI_STATE_AVG_SHIFT);
+}
+
+// Wait for state GPIO after bus phase, short spin then sleep on completion
+static rs_ret k_spi_wait_state_change(struct spi_dev_if_priv *dev_if_priv, u32 timeout_us)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_if_hs_stats *hs_stats = &dev_if_priv->hs_stats;
+	ktime_t start = ktime_get();
+	u32 spin_us = k_spi_state_spin_us(dev_if_priv);
+	s64 lat_us = timeout_us;
+
+	do {
+		if (try_wait_for_completion(&dev_if_priv->state_done)) {
+			hs_stats->spin_cnt++;
 			ret = RS_SUCCESS;
 			break;
 		}
-		udelay(10);
+		cpu_relax();
+	} while (ktime_us_delta(ktime_get(), start) < spin_us);
+
+	if (ret != RS_SUCCESS) {
+		if (wait_for_completion_timeout(&dev_if_priv->state_done, usecs_to_jiffies(timeout_us)) > 0) {
+			hs_stats->sleep_cnt++;
+			ret = RS_SUCCESS;
+		} else {
+			hs_stats->timeout_cnt++;
+		}
+	}
+
+	if (ret == RS_SUCCESS) {
+		lat_us = ktime_us_delta(dev_if_priv->state_at, dev_if_priv->state_start);
+		if (lat_us < 0) {
+			lat_us = 0;
+		} else if (lat_us > timeout_us) {
+			lat_us = timeout_us;
+		}
 	}
+	k_spi_state_stats(dev_if_priv, (u32)lat_us);
+	hs_stats->spin_us = spin_us;
 
 	return ret;
 }
@@ -311,6 +391,10 @@ static rs_ret k_spi_init(struct rs_c_if *c_if)
 
 #if USE_GPIO_STATE
 		if (ret == RS_SUCCESS) {
+			init_completion(&dev_if_priv->state_done);
+			dev_if_priv->state_lat_avg = SPI_STATE_SPIN_MAX_US << SPI_STATE_AVG_SHIFT;
+			(void)rs_k_memset(&dev_if_priv->hs_stats, 0, sizeof(struct rs_c_if_hs_stats));
+
 			if(temp_gpio_irq_state < 0) {
 				temp_gpio_irq_state = GPIO22;	
 			}
@@ -452,9 +536,9 @@ static inline s32 bus_write(struct rs_c_if *c_if, u8 *buf, s32 len)
 			spi_message_add_tail(&data_tr, &msg);
 
 #if USE_GPIO_STATE
-			k_spi_reset_state_change();
+			k_spi_reset_state_change(dev_if_priv);
 			err = spi_sync(spi, &msg);
-			k_spi_wait_state_change(2000);
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
 #else
 			err = spi_sync(spi, &msg);
 			udelay(200);
@@ -470,9 +554,91 @@ static inline s32 bus_write(struct rs_c_if *c_if, u8 *buf, s32 len)
 
 			spi_message_add_tail(&data_tr, &msg);
 #if USE_GPIO_STATE
-			k_spi_reset_state_change();
+			k_spi_reset_state_change(dev_if_priv);
 			err = spi_sync(spi, &msg);
-			k_spi_wait_state_change(2000);
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
+#else
+			err = spi_sync(spi, &msg);
+#endif
+		}
+	}
+
+	return err;
+}
+
+static inline s32 bus_writev(struct rs_c_if *c_if, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	s32 err = -1;
+	struct spi_device *spi = NULL;
+	struct spi_message msg = { 0 };
+	struct spi_transfer data_tr = { 0 };
+	struct spi_dev_if_priv *dev_if_priv = NULL;
+	char write_cmd[4] = {RS_CMD_DATA_TX, 0, 0, 0};
+	u32 len = 0;
+	u32 pad = 0;
+	u32 bounce = 0;
+	u8 i = 0;
+
+	for (i = 0; i < frag_num; i++) {
+		len += frag[i].len;
+	}
+	*(unsigned short *)(&write_cmd[2]) = (unsigned short)len;
+
+	spi = rs_c_if_get_dev(c_if);
+
+	if ((spi != NULL) && (len > 0) && (frag_num <= RS_C_IF_FRAG_MAX)) {
+		dev_if_priv = c_if->if_dev.dev_if_priv;
+
+		if ((dev_if_priv != NULL) && (dev_if_priv->tx_buff != NULL) &&
+		    (((len + 3) & ~3U) <= dev_if_priv->buff_len)) {
+			(void)rs_k_memcpy(dev_if_priv->tx_buff, write_cmd, 4);
+			spi_message_init(&msg);
+
+			data_tr.tx_buf = dev_if_priv->tx_buff;
+			data_tr.rx_buf = NULL;
+			data_tr.len = 4;
+
+			spi_message_add_tail(&data_tr, &msg);
+
+#if USE_GPIO_STATE
+			k_spi_reset_state_change(dev_if_priv);
+			err = spi_sync(spi, &msg);
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
+#else
+			err = spi_sync(spi, &msg);
+			udelay(200);
+#endif
+			// fragments are chained in one message, chip select is held over whole frame
+			spi_message_init(&msg);
+
+			// command is sent so its buffer is free, controller may DMA from fragments so ones
+			// it can not (e.g. static padding) are copied into it
+			for (i = 0; i < frag_num; i++) {
+				(void)rs_k_memset(&dev_if_priv->frag_tr[i], 0, sizeof(struct spi_transfer));
+				dev_if_priv->frag_tr[i].tx_buf = frag[i].data;
+				if (rs_k_mem_dma_safe(frag[i].data) == FALSE) {
+					(void)rs_k_memcpy(dev_if_priv->tx_buff + bounce, frag[i].data,
+							  frag[i].len);
+					dev_if_priv->frag_tr[i].tx_buf = dev_if_priv->tx_buff + bounce;
+					bounce += frag[i].len;
+				}
+				dev_if_priv->frag_tr[i].len = frag[i].len;
+				spi_message_add_tail(&dev_if_priv->frag_tr[i], &msg);
+			}
+
+			// frame is padded to 4 bytes
+			pad = ((((len - 1) / 4) + 1) * 4) - len;
+			if (pad > 0) {
+				(void)rs_k_memset(dev_if_priv->tx_buff + bounce, 0, pad);
+				(void)rs_k_memset(&dev_if_priv->frag_tr[i], 0, sizeof(struct spi_transfer));
+				dev_if_priv->frag_tr[i].tx_buf = dev_if_priv->tx_buff + bounce;
+				dev_if_priv->frag_tr[i].len = pad;
+				spi_message_add_tail(&dev_if_priv->frag_tr[i], &msg);
+			}
+#if USE_GPIO_STATE
+			k_spi_reset_state_change(dev_if_priv);
+			err = spi_sync(spi, &msg);
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
 #else
 			err = spi_sync(spi, &msg);
 #endif
@@ -488,8 +654,11 @@ static inline s32 bus_read(struct rs_c_if *c_if, u8 *buf, s32 len)
 	struct spi_device *spi = NULL;
 	struct spi_message msg = { 0 };
 	struct spi_transfer data_tr = { 0 };
+	struct spi_transfer rest_tr = { 0 };
 	struct spi_dev_if_priv *dev_if_priv = NULL;
+	struct rs_c_data *head = NULL;
 	char read_cmd[4] = {RS_CMD_DATA_RX, 0, 0, 0};
+	u32 frame_len = 0;
 
 	spi = rs_c_if_get_dev(c_if);
 
@@ -497,7 +666,7 @@ static inline s32 bus_read(struct rs_c_if *c_if, u8 *buf, s32 len)
 		dev_if_priv = c_if->if_dev.dev_if_priv;
 
 		if ((dev_if_priv != NULL) && (dev_if_priv->rx_buff != NULL) &&
-		    (len <= dev_if_priv->buff_len)) {
+		    (len <= dev_if_priv->buff_len) && (len >= SPI_RX_HEAD_LEN)) {
 								
 			(void)rs_k_memcpy(dev_if_priv->tx_buff, read_cmd, 4);
 			spi_message_init(&msg);
@@ -509,31 +678,175 @@ static inline s32 bus_read(struct rs_c_if *c_if, u8 *buf, s32 len)
 			spi_message_add_tail(&data_tr, &msg);
 
 #if USE_GPIO_STATE
-			k_spi_reset_state_change();
+			k_spi_reset_state_change(dev_if_priv);
 			err = spi_sync(spi, &msg);
-			k_spi_wait_state_change(2000);
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
 #else
 			err = spi_sync(spi, &msg);
 			udelay(200);
 #endif
+			// header first, chip select is held and only rest of frame is clocked in
+			spi_bus_lock(spi->controller);
+
 			spi_message_init(&msg);
 
 			data_tr.tx_buf = NULL;
 			data_tr.rx_buf = dev_if_priv->rx_buff;
-			data_tr.len = dev_if_priv->buff_len;
+			data_tr.len = SPI_RX_HEAD_LEN;
+			data_tr.cs_change = 1;
+
+			spi_message_add_tail(&data_tr, &msg);
+
+#if USE_GPIO_STATE
+			k_spi_reset_state_change(dev_if_priv);
+#endif
+			err = spi_sync_locked(spi, &msg);
+			if (err == 0) {
+				head = (struct rs_c_data *)dev_if_priv->rx_buff;
+				frame_len = len;
+				if (RS_C_IS_CMD(head->cmd)) {
+					frame_len = RS_C_GET_DATA_SIZE(head->ext_len, head->data_len);
+					frame_len = SPI_ALIGN_4(frame_len);
+				}
+				if (frame_len > len) {
+					frame_len = len;
+				} else if (frame_len < SPI_RX_HEAD_LEN) {
+					frame_len = SPI_RX_HEAD_LEN;
+				}
+
+				// empty transfer still releases chip select
+				spi_message_init(&msg);
+
+				rest_tr.tx_buf = NULL;
+				rest_tr.rx_buf = dev_if_priv->rx_buff + SPI_RX_HEAD_LEN;
+				rest_tr.len = frame_len - SPI_RX_HEAD_LEN;
+
+				spi_message_add_tail(&rest_tr, &msg);
+
+				err = spi_sync_locked(spi, &msg);
+			}
+
+			spi_bus_unlock(spi->controller);
+#if USE_GPIO_STATE
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
+#endif
+			if (err == 0) {
+				(void)rs_k_memcpy(buf, dev_if_priv->rx_buff, frame_len);
+			}
+		}
+	}
+
+	return err;
+}
+
+// Same as bus_read but frame goes straight into segments, header into first one and rest of frame
+// chained over the others, chip select is held over whole frame
+static inline s32 bus_readv(struct rs_c_if *c_if, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	s32 err = -1;
+	struct spi_device *spi = NULL;
+	struct spi_message msg = { 0 };
+	struct spi_transfer data_tr = { 0 };
+	struct spi_dev_if_priv *dev_if_priv = NULL;
+	struct rs_c_data *head = NULL;
+	char read_cmd[4] = {RS_CMD_DATA_RX, 0, 0, 0};
+	u32 len = 0;
+	u32 frame_len = 0;
+	u32 pos = 0;
+	u32 off = 0;
+	u32 tr_len = 0;
+	u8 tr_num = 0;
+	u8 i = 0;
+
+	for (i = 0; i < frag_num; i++) {
+		len += frag[i].len;
+	}
+
+	spi = rs_c_if_get_dev(c_if);
+
+	if ((spi != NULL) && (frag_num > 0) && (frag_num <= RS_C_IF_FRAG_MAX) &&
+	    (frag[0].len >= SPI_RX_HEAD_LEN)) {
+		dev_if_priv = c_if->if_dev.dev_if_priv;
+
+		if ((dev_if_priv != NULL) && (dev_if_priv->tx_buff != NULL)) {
+			(void)rs_k_memcpy(dev_if_priv->tx_buff, read_cmd, 4);
+			spi_message_init(&msg);
+
+			data_tr.tx_buf = dev_if_priv->tx_buff;
+			data_tr.rx_buf = NULL;
+			data_tr.len = 4;
 
 			spi_message_add_tail(&data_tr, &msg);
 
 #if USE_GPIO_STATE
-			k_spi_reset_state_change();
+			k_spi_reset_state_change(dev_if_priv);
 			err = spi_sync(spi, &msg);
-			k_spi_wait_state_change(2000);
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
 #else
 			err = spi_sync(spi, &msg);
+			udelay(200);
+#endif
+			spi_bus_lock(spi->controller);
+
+			spi_message_init(&msg);
+
+			data_tr.tx_buf = NULL;
+			data_tr.rx_buf = frag[0].data;
+			data_tr.len = SPI_RX_HEAD_LEN;
+			data_tr.cs_change = 1;
+
+			spi_message_add_tail(&data_tr, &msg);
+
+#if USE_GPIO_STATE
+			k_spi_reset_state_change(dev_if_priv);
 #endif
+			err = spi_sync_locked(spi, &msg);
 			if (err == 0) {
-				(void)rs_k_memcpy(buf, dev_if_priv->rx_buff, len);
+				head = (struct rs_c_data *)frag[0].data;
+				frame_len = len;
+				if (RS_C_IS_CMD(head->cmd)) {
+					frame_len = RS_C_GET_DATA_SIZE(head->ext_len, head->data_len);
+					frame_len = SPI_ALIGN_4(frame_len);
+				}
+				if (frame_len > len) {
+					frame_len = len;
+				}
+
+				spi_message_init(&msg);
+
+				// segments are clocked in up to frame length only
+				pos = SPI_RX_HEAD_LEN;
+				for (i = 0; (i < frag_num) && (pos < frame_len); i++) {
+					off = (i == 0) ? SPI_RX_HEAD_LEN : 0;
+					tr_len = frag[i].len - off;
+					if (tr_len > frame_len - pos) {
+						tr_len = frame_len - pos;
+					}
+					if (tr_len > 0) {
+						(void)rs_k_memset(&dev_if_priv->frag_tr[tr_num], 0,
+								  sizeof(struct spi_transfer));
+						dev_if_priv->frag_tr[tr_num].rx_buf = frag[i].data + off;
+						dev_if_priv->frag_tr[tr_num].len = tr_len;
+						spi_message_add_tail(&dev_if_priv->frag_tr[tr_num], &msg);
+						tr_num++;
+						pos += tr_len;
+					}
+				}
+
+				// empty transfer still releases chip select
+				if (tr_num == 0) {
+					(void)rs_k_memset(&dev_if_priv->frag_tr[0], 0,
+							  sizeof(struct spi_transfer));
+					spi_message_add_tail(&dev_if_priv->frag_tr[0], &msg);
+				}
+
+				err = spi_sync_locked(spi, &msg);
 			}
+
+			spi_bus_unlock(spi->controller);
+#if USE_GPIO_STATE
+			(void)k_spi_wait_state_change(dev_if_priv, 2000);
+#endif
 		}
 	}
 
@@ -594,6 +907,71 @@ static rs_ret k_spi_write(struct rs_c_if *c_if, u32 addr, u8 *data, u32 len)
 	return ret;
 }
 
+static rs_ret k_spi_readv(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+#if USE_GPIO_STATE
+	C_IF_DEV_MUTEX_LOCK(c_if);
+	ret = bus_readv(c_if, frag, frag_num);
+	C_IF_DEV_MUTEX_UNLOCK(c_if);
+#else
+	udelay(500);
+	C_IF_DEV_MUTEX_LOCK(c_if);
+	ret = bus_readv(c_if, frag, frag_num);
+	C_IF_DEV_MUTEX_UNLOCK(c_if);
+#endif
+
+	RS_DBG("P:%s[%d]:r[%d]:addr 0x%x, frag [%d][%d]\n", __func__, __LINE__, ret, addr, frag_num,
+	       frag[0].len);
+
+	return ret;
+}
+
+static rs_ret k_spi_writev(struct rs_c_if *c_if, u32 addr, struct rs_c_if_frag *frag, u8 frag_num)
+{
+	rs_ret ret = RS_FAIL;
+#if USE_GPIO_STATE
+	C_IF_DEV_MUTEX_LOCK(c_if);
+	ret = bus_writev(c_if, frag, frag_num);
+	C_IF_DEV_MUTEX_UNLOCK(c_if);
+#else
+	udelay(500);
+	C_IF_DEV_MUTEX_LOCK(c_if);
+	ret = bus_writev(c_if, frag, frag_num);
+	C_IF_DEV_MUTEX_UNLOCK(c_if);
+#endif
+
+	RS_DBG("P:%s[%d]:r[%d]:addr 0x%x, frag [%d][%d]\n", __func__, __LINE__, ret, addr, frag_num,
+	       frag[0].len);
+
+	return ret;
+}
+
+// Segments of any length are chained transfers of one message
+static rs_ret k_spi_bus_capa(struct rs_c_if *c_if, struct rs_c_if_bus_capa *capa)
+{
+	capa->flags = RS_C_IF_BUS_READV | RS_C_IF_BUS_WRITEV;
+	capa->seg_max = RS_C_IF_FRAG_MAX;
+	capa->seg_align = 1;
+
+	return RS_SUCCESS;
+}
+
+static rs_ret k_spi_hs_stats(struct rs_c_if *c_if, struct rs_c_if_hs_stats *stats)
+{
+	rs_ret ret = RS_NOT_SUPPORT;
+#if USE_GPIO_STATE
+	struct spi_dev_if_priv *dev_if_priv = c_if->if_dev.dev_if_priv;
+
+	if (dev_if_priv != NULL) {
+		(void)rs_k_memcpy(stats, &dev_if_priv->hs_stats, sizeof(struct rs_c_if_hs_stats));
+		ret = RS_SUCCESS;
+	}
+#endif
+
+	return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static u32 local_crc32(const void *buf, size_t size)
@@ -725,6 +1103,10 @@ static int k_spi_rrq61000_remove(struct spi_device *spi_dev)
 		(void)rs_c_if_set_dev_if(c_if, NULL);
 		c_if->if_ops.read = NULL;
 		c_if->if_ops.write = NULL;
+		c_if->if_ops.readv = NULL;
+		c_if->if_ops.writev = NULL;
+		c_if->if_ops.bus_capa = NULL;
+		c_if->if_ops.hs_stats = NULL;
 		c_if->if_ops.read_status = NULL;
 		c_if->if_ops.reload = NULL;
 
@@ -791,7 +1173,7 @@ static rs_ret k_spi_rrq61000_probe(struct spi_device *spi_dev)
 	if ((c_if != NULL) && (id != NULL)) {
 		dev_if_priv = rs_k_calloc(sizeof(struct spi_dev_if_priv));
 		if (dev_if_priv != NULL) {
-			dev_if_priv->buff_len = sizeof(struct rs_c_rx_data);
+			dev_if_priv->buff_len = RS_C_RX_BUF_SIZE;
 			dev_if_priv->rx_buff = rs_k_calloc(dev_if_priv->buff_len);
 			dev_if_priv->tx_buff = rs_k_calloc(dev_if_priv->buff_len);
 
@@ -815,6 +1197,10 @@ static rs_ret k_spi_rrq61000_probe(struct spi_device *spi_dev)
 			(void)rs_c_if_set_dev_if(c_if, (void *)&spi_dev->dev);
 			c_if->if_ops.read = k_spi_read;
 			c_if->if_ops.write = k_spi_write;
+			c_if->if_ops.readv = k_spi_readv;
+			c_if->if_ops.writev = k_spi_writev;
+			c_if->if_ops.bus_capa = k_spi_bus_capa;
+			c_if->if_ops.hs_stats = k_spi_hs_stats;
 			c_if->if_ops.read_status = k_spi_read_status;
 			c_if->if_ops.reload = k_spi_reload;
 
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include <linux/ktime.h>
+
+#include "rs_type.h"
+
+#include "rs_k_time.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Get monotonic time in microseconds, wraps around in about 71 minutes
+u32 rs_k_time_get_us(void)
+{
+	return (u32)ktime_to_us(ktime_get());
+}
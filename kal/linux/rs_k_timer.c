@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include <linux/version.h>
+#include <linux/timer.h>
+#include <linux/jiffies.h>
+#include <linux/hrtimer.h>
+
+#include "rs_type.h"
+#include "rs_k_mem.h"
+#include "rs_c_dbg.h"
+
+#include "rs_k_timer.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 16, 0)
+#define K_TIMER_CONTAINER_OF(var, timer) timer_container_of(var, timer, timer)
+#else
+#define K_TIMER_CONTAINER_OF(var, timer) from_timer(var, timer, timer)
+#endif
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 2, 0)
+#define K_TIMER_DELETE_SYNC(timer) timer_delete_sync(timer)
+#else
+#define K_TIMER_DELETE_SYNC(timer) del_timer_sync(timer)
+#endif
+
+// callback of high resolution timer runs in softirq like one of timer_list
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 13, 0)
+#define K_HRTIMER_SETUP(timer, func) hrtimer_setup(timer, func, CLOCK_MONOTONIC, HRTIMER_MODE_REL_SOFT)
+#else
+#define K_HRTIMER_SETUP(timer, func)                                             \
+	do {                                                                     \
+		hrtimer_init(timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL_SOFT);     \
+		(timer)->function = func;                                        \
+	} while (0)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+struct k_timer {
+	struct timer_list timer;
+	// fires in usec instead of jiffies
+	struct hrtimer hrtimer;
+	bool hr;
+
+	rs_k_timer_cb *cb_func;
+	void *arg;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+static void k_timer_handler(struct timer_list *timer)
+{
+	struct k_timer *temp_timer = K_TIMER_CONTAINER_OF(temp_timer, timer);
+
+	if ((temp_timer != NULL) && (temp_timer->cb_func != NULL)) {
+		(void)(temp_timer->cb_func)(temp_timer->arg);
+	}
+}
+
+static enum hrtimer_restart k_hrtimer_handler(struct hrtimer *hrtimer)
+{
+	struct k_timer *temp_timer = container_of(hrtimer, struct k_timer, hrtimer);
+
+	if (temp_timer->cb_func != NULL) {
+		(void)(temp_timer->cb_func)(temp_timer->arg);
+	}
+
+	return HRTIMER_NORESTART;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Create one-shot timer
+rs_ret rs_k_timer_create(struct rs_k_timer *k_timer, rs_k_timer_cb *cb_func, void *arg)
+{
+	rs_ret ret = RS_FAIL;
+	struct k_timer *temp_timer = NULL;
+
+	if ((k_timer != NULL) && (cb_func != NULL)) {
+		temp_timer = rs_k_calloc(sizeof(struct k_timer));
+		if (temp_timer) {
+			temp_timer->cb_func = cb_func;
+			temp_timer->arg = arg;
+
+			timer_setup(&(temp_timer->timer), k_timer_handler, 0);
+
+			k_timer->timer = temp_timer;
+
+			ret = RS_SUCCESS;
+		} else {
+			ret = RS_MEMORY_FAIL;
+		}
+	}
+
+	return ret;
+}
+
+// Create one-shot high resolution timer
+rs_ret rs_k_timer_create_hr(struct rs_k_timer *k_timer, rs_k_timer_cb *cb_func, void *arg)
+{
+	rs_ret ret = RS_FAIL;
+	struct k_timer *temp_timer = NULL;
+
+	if ((k_timer != NULL) && (cb_func != NULL)) {
+		temp_timer = rs_k_calloc(sizeof(struct k_timer));
+		if (temp_timer) {
+			temp_timer->cb_func = cb_func;
+			temp_timer->arg = arg;
+			temp_timer->hr = TRUE;
+
+			K_HRTIMER_SETUP(&(temp_timer->hrtimer), k_hrtimer_handler);
+
+			k_timer->timer = temp_timer;
+
+			ret = RS_SUCCESS;
+		} else {
+			ret = RS_MEMORY_FAIL;
+		}
+	}
+
+	return ret;
+}
+
+// Destroy timer, waits running callback
+rs_ret rs_k_timer_destroy(struct rs_k_timer *k_timer)
+{
+	rs_ret ret = RS_FAIL;
+	struct k_timer *temp_timer = NULL;
+
+	if ((k_timer != NULL) && (k_timer->timer != NULL)) {
+		temp_timer = k_timer->timer;
+
+		if (temp_timer->hr == TRUE) {
+			(void)hrtimer_cancel(&(temp_timer->hrtimer));
+		} else {
+			(void)K_TIMER_DELETE_SYNC(&(temp_timer->timer));
+		}
+
+		rs_k_free(temp_timer);
+		k_timer->timer = NULL;
+
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+// Start timer if not pending, RS_BUSY if already pending
+rs_ret rs_k_timer_start(struct rs_k_timer *k_timer, u32 usec)
+{
+	rs_ret ret = RS_FAIL;
+	struct k_timer *temp_timer = NULL;
+
+	if ((k_timer != NULL) && (k_timer->timer != NULL)) {
+		temp_timer = k_timer->timer;
+
+		if (temp_timer->hr == TRUE) {
+			if (hrtimer_is_queued(&(temp_timer->hrtimer))) {
+				ret = RS_BUSY;
+			} else {
+				hrtimer_start(&(temp_timer->hrtimer), ns_to_ktime((u64)usec * NSEC_PER_USEC),
+					      HRTIMER_MODE_REL_SOFT);
+				ret = RS_SUCCESS;
+			}
+		} else if (timer_pending(&(temp_timer->timer))) {
+			ret = RS_BUSY;
+		} else {
+			mod_timer(&(temp_timer->timer), jiffies + usecs_to_jiffies(usec));
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
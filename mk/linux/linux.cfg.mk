@@ -61,3 +61,30 @@ CONFIG_RSWLAN_DBG_STATS ?= y
 ifeq ($(CONFIG_RSWLAN_DBG_STATS), y)
 EXTRA_CFLAGS += -DCONFIG_DBG_STATS
 endif
+
+# RX data delivered from NAPI poll with GRO instead of RX DATA thread
+CONFIG_RSWLAN_NAPI ?= y
+ifeq ($(CONFIG_RSWLAN_NAPI), y)
+EXTRA_CFLAGS += -DCONFIG_RS_NAPI
+endif
+
+# XDP program run in NAPI poll on RX buffer before sk_buff is built, needs kernel 5.13 or later
+CONFIG_RSWLAN_XDP ?= n
+ifneq ($(CONFIG_RSWLAN_NAPI), y)
+override CONFIG_RSWLAN_XDP := n
+endif
+ifeq ($(CONFIG_RSWLAN_XDP), y)
+EXTRA_CFLAGS += -DCONFIG_RS_XDP
+endif
+
+# DebugFS q_bench : rs_c_q + spin lock vs. SPSC ring two thread benchmark
+CONFIG_RSWLAN_Q_BENCH ?= n
+ifeq ($(CONFIG_RSWLAN_Q_BENCH), y)
+EXTRA_CFLAGS += -DCONFIG_RS_Q_BENCH
+endif
+
+# DebugFS selftest : A-MSDU subframe round trip and other self-tests run on demand
+CONFIG_RSWLAN_SELFTEST ?= n
+ifeq ($(CONFIG_RSWLAN_SELFTEST), y)
+EXTRA_CFLAGS += -DCONFIG_RS_SELFTEST
+endif
@@ -20,6 +20,7 @@ NET_OS_SRCS := rs_net.c \
 		rs_net_ctrl.c \
 		rs_net_rx_indi.c \
 		rs_net_rx_data.c \
+		rs_net_rx_reorder.c \
 		rs_net_tx_data.c	\
 		rs_net_testmode.c	\
 		rs_net_stats.c
@@ -28,6 +29,10 @@ ifeq ($(CONFIG_RSWLAN_5G_DFS),y)
 NET_OS_SRCS += rs_net_dfs.c
 endif
 
+ifeq ($(CONFIG_RSWLAN_XDP),y)
+NET_OS_SRCS += rs_net_xdp.c
+endif
+
 MAIN_OS_SDIO_SRCS := rs_main_sdio.c
 MAIN_OS_SPI_SRCS := rs_main_spi.c
 MAIN_OS_SRCS := rs_main.c
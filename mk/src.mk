@@ -3,6 +3,7 @@
 DRV_SDIO_SRCS := $(OS_SDIO_SRCS)
 DRV_SPI_SRCS := $(OS_SPI_SRCS)
 DRV_SRCS := $(OS_SRCS) \
+		rs_k_atomic.c \
 		rs_k_dbg.c \
 		rs_k_event.c \
 		rs_k_mem.c \
@@ -10,10 +11,14 @@ DRV_SRCS := $(OS_SRCS) \
 		rs_k_if.c \
 		rs_k_spin_lock.c \
 		rs_k_thread.c \
+		rs_k_time.c \
+		rs_k_timer.c \
 		rs_k_workqueue.c \
 		rs_c_if.c \
 		rs_core.c \
 		rs_c_q.c \
+		rs_c_ring.c \
+		rs_c_pool.c \
 		rs_c_ctrl.c \
 		rs_c_indi.c \
 		rs_c_rx.c \
@@ -18,11 +18,17 @@
 
 #define RS_NET_CH_INIT_VALUE	  (0xFF)
 
+#define RS_NET_STA_MAX		  (4)
+#define RS_NET_VIF_DEV_MAX	  (2)
+
 #define RS_NET_INID_BUF_Q_MAX	  (64)
 #define RS_NET_RX_BUF_Q_MAX	  (64)
-#define RS_NET_TX_BUF_Q_MAX	  (128)
 #define RS_NET_TX_POWER_BUF_Q_MAX (32)
 
+// TX data queue per (sta_idx, tid), one station set per station table entry
+#define RS_NET_TXQ_STA_MAX	  (RS_NET_STA_MAX + RS_NET_VIF_DEV_MAX)
+#define RS_NET_TXQ_BUF_Q_MAX	  (64)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -78,6 +78,9 @@ rs_ret rs_net_ctrl_get_fw_mac_addr(struct rs_c_if *c_if, u8 *mac_addr);
 // Get F/W version
 rs_ret rs_net_ctrl_get_fw_ver(struct rs_c_if *c_if, struct rs_c_fw_ver_rsp *rsp_data);
 
+// Enable IF capabilities F/W advertised in its version
+rs_ret rs_net_ctrl_if_capa(struct rs_c_if *c_if, struct rs_c_fw_ver_rsp *fw_ver);
+
 // Add network interface
 rs_ret rs_net_ctrl_if_add(struct rs_c_if *c_if, const u8 *mac_addr, u8 iftype, bool p2p,
 			  struct rs_c_add_if_rsp *rsp_data);
@@ -91,8 +94,9 @@ rs_ret rs_net_ctrl_me_config(struct rs_c_if *c_if);
 // Set MLME Channel Config
 rs_ret rs_net_ctrl_me_chan_config(struct rs_c_if *c_if);
 
-// Start scan
-rs_ret rs_net_ctrl_scan_start(struct rs_c_if *c_if, struct cfg80211_scan_request *param);
+// Start scan of ch_num channels of request from ch_start
+rs_ret rs_net_ctrl_scan_start(struct rs_c_if *c_if, struct cfg80211_scan_request *param, u16 ch_start,
+			      u16 ch_num);
 
 // Cancel scan
 rs_ret rs_net_ctrl_scan_cancel(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv);
@@ -168,4 +172,8 @@ rs_ret rs_net_ctrl_time_sync_with_dev(struct rs_c_if *c_if);
 #ifdef CONFIG_DBG_STATS
 rs_ret rs_net_ctrl_dbg_stats_tx_req(struct rs_c_if *c_if, u8 req, struct rs_c_dbg_stats_tx_rsp *rsp_data);
 #endif
+#ifdef CONFIG_RS_SELFTEST
+// Run IF capability handshake of F/W without capability on mock I/F, RS_SUCCESS when it falls back
+rs_ret rs_net_ctrl_if_capa_selftest(struct rs_c_if *c_if);
+#endif
 #endif /* RS_NET_CTRL_H */
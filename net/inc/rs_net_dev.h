@@ -39,6 +39,9 @@ rs_ret rs_net_dev_set_monitor_ops(rs_net_dev_t *ndev);
 // Send received packets to net_device.
 rs_ret rs_net_dev_rx(rs_net_dev_t *ndev, u8 *skb);
 
+// Receive skb through GRO of NAPI
+rs_ret rs_net_dev_rx_gro(rs_net_dev_t *ndev, void *napi, u8 *skb);
+
 // Check whether interface is up?
 rs_ret rs_net_if_is_up(rs_net_dev_t *ndev);
 
@@ -51,4 +54,22 @@ rs_ret rs_net_vif_idx_is_up(struct rs_c_if *c_if, s16 vif_idx);
 // Control network transmittion
 rs_ret rs_net_if_tx_stop(struct rs_c_if *c_if, s8 vif_idx, bool stop);
 
+// Control network transmittion of one netdev queue
+rs_ret rs_net_if_txq_stop(struct rs_c_if *c_if, s8 vif_idx, u16 txq_idx, bool stop);
+
+// Account data frame queued to core in BQL
+void rs_net_tx_data_queued(struct rs_c_if *c_if, s8 vif_idx, u8 *skb);
+
+// Account data frame sent or dropped by core in BQL
+void rs_net_tx_data_done(struct rs_c_if *c_if, s8 vif_idx, u8 *skb);
+
+// Get IF TX header of frame queued to core
+struct rs_c_tx_hdr *rs_net_tx_data_hdr(u8 *skb);
+
+// Split frame into IF TX header and data fragments, returns fragment count or 0
+u8 rs_net_tx_data_frag(u8 *skb, struct rs_c_if_frag *frag, u8 frag_max);
+
+// Append sub_skb to A-MSDU of skb within amsdu_len bytes, sub_skb is freed with skb on success
+rs_ret rs_net_tx_data_amsdu(u8 *skb, u8 *sub_skb, u16 amsdu_len);
+
 #endif /* RS_NET_DEV_H */
@@ -92,4 +92,10 @@ bool rs_net_params_get_he_ul_on(struct rs_c_if *c_if);
 
 u32 rs_net_params_get_uapsd_threshold(struct rs_c_if *c_if);
 
+// RX data queues of rx_queues module parameter, 1 without NAPI
+u8 rs_net_params_get_rx_queues(struct rs_c_if *c_if);
+
+// CPU of RX data queue from rx_cpus module parameter, -1 if not given or not online
+s32 rs_net_params_get_rx_cpu(struct rs_c_if *c_if, u8 q_idx);
+
 #endif /* RS_NET_PARAMS_H */
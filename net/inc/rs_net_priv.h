@@ -13,6 +13,16 @@
 #include "rs_type.h"
 #include "rs_c_cmd.h"
 #include "rs_c_data.h"
+#include "rs_c_rx.h"
+#include "rs_k_timer.h"
+#include "rs_net.h"
+
+#include <linux/u64_stats_sync.h>
+
+#ifdef CONFIG_RS_XDP
+#include <linux/bpf.h>
+#include <net/xdp.h>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
@@ -26,15 +36,17 @@
 #define RS_NET_INVALID_IFTYPE	 (0xFF)
 #define RS_NET_WDEV_IF_TYPE(vif) (vif->wdev.iftype)
 
+#ifdef CONFIG_RS_XDP
+// XDP verdict counters, indexed by enum xdp_action
+#define RS_NET_XDP_ACT_MAX (XDP_REDIRECT + 1)
+#endif
+
 #define RS_NET_MU_GROUP_MAX	 (1)
 #define RS_NET_CHANINFO_MAX	 (3)
 
 // maximum number of TX frame per RoC
 #define RS_NET_ROC_TX		 5
 
-#define RS_NET_STA_MAX		 (4)
-#define RS_NET_VIF_DEV_MAX	 (2)
-
 // Maximum number of AP_VLAN interfaces allowed.
 // At max we can have one AP_VLAN per station, but we also limit the
 // maximum number of interface to 16 (to fit in avail_idx_map)
@@ -229,8 +241,22 @@ struct rs_net_tdls { // TODO : Change
 	bool chsw_allowed;
 };
 
+// Counters of one CPU, each update touches this cache line only
+struct rs_net_pcpu_stats {
+	struct u64_stats_sync syncp;
+	u64 rx_packets;
+	u64 rx_bytes;
+	u64 rx_multicast;
+	u64 rx_dropped;
+	u64 tx_packets;
+	u64 tx_bytes;
+	u64 tx_dropped;
+} __aligned(SMP_CACHE_BYTES);
+
 struct rs_net_sta_stats {
+	struct rs_net_pcpu_stats __percpu *pcpu;
 	u32 last_acttive_time;
+	// RX header of first frame in each jiffy, rate info is sampled rather than copied per frame
 	struct rs_c_rx_ext_hdr last_rx_data_ext;
 	struct rs_c_rx_ext_hdr last_stats;
 };
@@ -268,6 +294,8 @@ struct rs_net_sta_priv { // TODO : Change
 	int listen_interval;
 	struct twt_setup_ind twt_ind;
 	struct list_head he_mu;
+	// core TX queues of this station, RS_C_TX_TID_MAX entries by tid
+	struct rs_c_txq *txq;
 };
 
 //////////////
@@ -291,6 +319,8 @@ struct rs_net_vif_priv {
 	// Fullmac
 
 	u8 net_tx_stopped;
+	// bumped on open, BQL completion of frames queued before is skipped
+	u32 bql_epoch;
 
 	struct rs_net_key_info key[RS_NET_KEYS_MAX];
 	u8 drv_vif_index;
@@ -299,6 +329,8 @@ struct rs_net_vif_priv {
 	bool use_4addr;
 	bool is_resending; // multicast frame is resending
 	s32 generation; // station generated by this vif
+	// netdev counters, summed by ndo_get_stats64
+	struct rs_net_pcpu_stats __percpu *pcpu_stats;
 	union {
 		struct {
 			u32 flags;
@@ -328,6 +360,18 @@ struct rs_net_vif_priv {
 		} ap_vlan;
 	};
 
+#ifdef CONFIG_RS_XDP
+	// XDP program run on RX buffers of this vif before sk_buff is built
+	struct {
+		struct bpf_prog __rcu *prog;
+		struct xdp_rxq_info rxq;
+		u32 act_cnt[RS_NET_XDP_ACT_MAX];
+		// frames of XDP_TX and ndo_xdp_xmit, errors are frames TX path did not take
+		u32 xmit_cnt;
+		u32 xmit_err_cnt;
+	} xdp;
+#endif
+
 	///////////
 };
 
@@ -534,6 +578,25 @@ struct rs_net_dbg_stats {
 };
 #endif
 
+#ifdef CONFIG_RS_NAPI
+// NAPI of one core RX data queue
+struct rs_net_rx_napi {
+	struct napi_struct napi;
+	struct rs_net_cfg80211_priv *net_priv;
+	u8 q_idx;
+	// CPU poll is steered to by IPI, -1 to poll on CPU of RX thread
+	s32 cpu;
+	call_single_data_t csd;
+#ifdef CONFIG_RS_XDP
+	// XDP_REDIRECT frames wait for flush at end of poll
+	bool xdp_flush;
+#endif
+	u32 poll_cnt;
+	u32 frame_cnt;
+	u32 ipi_cnt;
+};
+#endif
+
 // rswlan private data in wihpy
 struct rs_net_cfg80211_priv {
 	struct device *dev_if;
@@ -566,6 +629,13 @@ struct rs_net_cfg80211_priv {
 	u8 chaninfo_index;
 	struct rs_net_remain_on_channel *roc;
 	struct cfg80211_scan_request *scan_request;
+	// scan_request is sent in chunks of channels, data is served between them
+	struct {
+		struct delayed_work work;
+		u16 next;
+		u16 chunk;
+		bool abort;
+	} scan_chunk;
 	struct rs_net_dfs_priv dfs;
 
 	struct rs_c_survey_info survey_table[RS_C_SCAN_CHANNEL_MAX];
@@ -576,6 +646,25 @@ struct rs_net_cfg80211_priv {
 #ifdef CONFIG_DBG_STATS
 	struct rs_net_dbg_stats dbg_stats;
 #endif
+
+	// host reorder of MPDUs F/W forwards unordered, win is [sta_idx * RS_NET_RX_REORDER_TID_MAX + tid]
+	// win is freed after RCU grace period, RX path and timer take windows under RCU read lock
+	struct {
+		struct rs_net_rx_reorder __rcu *win;
+		// releases MPDUs held longer than reorder timeout
+		struct rs_k_timer timer;
+	} rx_reorder;
+
+#ifdef CONFIG_RS_NAPI
+	// RX delivery of all vifs, on dummy netdev as frames of one queue go to several vifs
+	struct {
+		struct net_device *ndev;
+		// one per core RX data queue
+		struct rs_net_rx_napi q[RS_C_RX_DATA_Q_MAX];
+		u8 q_num;
+		bool enabled;
+	} rx_napi;
+#endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
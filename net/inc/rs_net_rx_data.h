@@ -11,20 +11,52 @@
 /// INCLUDE
 
 #include "rs_type.h"
+#include "rs_c_data.h"
+
+struct rs_net_cfg80211_priv;
+struct rs_net_rx_napi;
+struct sk_buff_head;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
+#define RS_NET_RX_CB(skb) ((struct rs_net_rx_cb *)((struct sk_buff *)(skb))->cb)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
+// skb control buffer of received MPDU until it is delivered
+struct rs_net_rx_cb {
+	struct rs_c_rx_ext_hdr ext_hdr;
+	// time MPDU was put in reorder buffer
+	unsigned long rx_jiffies;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL VARIABLE
 
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
-// RX Data handler
-rs_ret rs_net_rx_data(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data);
+// RX Data handler, taken is set when rx_data buffer became sk_buff head
+rs_ret rs_net_rx_data(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data, bool *taken);
+
+// Deliver MPDUs of list as a batch, through GRO from NAPI poll only
+rs_ret rs_net_rx_data_deliver(struct rs_net_cfg80211_priv *net_priv, struct sk_buff_head *list, bool gro);
+
+#ifdef CONFIG_RS_NAPI
+// Add and enable RX NAPIs of wiphy, one per RX data queue
+rs_ret rs_net_rx_napi_init(struct rs_c_if *c_if);
+
+// Disable and delete RX NAPIs of wiphy
+rs_ret rs_net_rx_napi_deinit(struct rs_c_if *c_if);
+
+// Schedule RX NAPI of core RX data queue q_idx, on CPU it is steered to
+void rs_net_rx_data_schedule(struct rs_c_if *c_if, u8 q_idx);
+
+// RX NAPI of queue MPDU with ext_hdr came in
+struct rs_net_rx_napi *rs_net_rx_napi_get(struct rs_net_cfg80211_priv *net_priv,
+					  struct rs_c_rx_ext_hdr *ext_hdr);
+#endif
 
 #endif /* RS_NET_RX_DATA_H */
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+#ifndef RS_NET_RX_REORDER_H
+#define RS_NET_RX_REORDER_H
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+#define RS_NET_RX_REORDER_TID_MAX (8)
+// largest HT BlockAck window, F/W caps ADDBA buffer size of HE sessions at it
+#define RS_NET_RX_REORDER_WIN	  (64)
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+struct rs_net_rx_reorder_stats {
+	u32 held_cnt;
+	u32 dup_cnt;
+	u32 old_cnt;
+	u32 timeout_cnt;
+};
+
+// Reorder window of one (sta_idx, tid), MPDU of sequence number sn is held in slot sn % window
+// Each window has own lock, RX queues of other CPUs take other windows
+struct rs_net_rx_reorder {
+	spinlock_t lock;
+	struct sk_buff *buf[RS_NET_RX_REORDER_WIN];
+	// held slots
+	u64 bitmap;
+	// sequence number released next
+	u16 head_sn;
+	// held sk_buffs, slots of MPDUs ended by XDP have none
+	u16 stored;
+	bool started;
+	struct rs_net_rx_reorder_stats stats;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Allocate reorder windows if F/W forwards MPDUs unordered
+rs_ret rs_net_rx_reorder_init(struct rs_net_cfg80211_priv *net_priv);
+
+// Free held MPDUs and reorder windows
+rs_ret rs_net_rx_reorder_deinit(struct rs_net_cfg80211_priv *net_priv);
+
+// Put MPDU in reorder window of its (sta_idx, tid), MPDUs released in order are added to list
+void rs_net_rx_reorder(struct rs_net_cfg80211_priv *net_priv, struct sk_buff *skb, struct sk_buff_head *list);
+
+// Mark sequence number of MPDU which did not become sk_buff as received, so window moves on
+void rs_net_rx_reorder_skip(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_ext_hdr *ext_hdr,
+			    struct sk_buff_head *list);
+
+// Free held MPDUs of station, its next MPDU starts new windows
+void rs_net_rx_reorder_sta_reset(struct rs_net_cfg80211_priv *net_priv, u8 sta_idx);
+
+// Sum statistics of all windows, FALSE if host does not reorder
+bool rs_net_rx_reorder_get_stats(struct rs_net_cfg80211_priv *net_priv,
+				 struct rs_net_rx_reorder_stats *stats);
+
+#endif /* RS_NET_RX_REORDER_H */
@@ -33,7 +33,22 @@ void rs_net_skb_free(u8 *skb);
 // Get data buffer from sk_buff
 s32 rs_net_skb_get_data(u8 *skb, u8 **out_data);
 
-// Add IF TX Header to skb_data
-u8 *rs_net_skb_add_tx_hdr(u8 *skb, u8 hdr_size);
+// Get flow hash of sk_buff
+u32 rs_net_skb_get_hash(u8 *skb);
+
+// Set ECN congestion experienced, fails if flow is not ECN capable
+rs_ret rs_net_skb_set_ce(u8 *skb);
+
+// Allocate RX buffer of len bytes, it can become sk_buff head without copy
+u8 *rs_net_skb_rx_buf_alloc(u32 len);
+
+// Free RX buffer which did not become sk_buff
+void rs_net_skb_rx_buf_free(u8 *buf);
+
+// Build sk_buff on RX buffer of len bytes, holding data_len bytes from offset
+u8 *rs_net_skb_rx_build(u8 *buf, u32 len, u32 offset, u32 data_len);
+
+// Get start of RX buffer of len bytes with its headroom, size is of whole buffer with tailroom
+u8 *rs_net_skb_rx_buf_head(u8 *buf, u32 len, u32 *size);
 
 #endif /* RS_NET_SKB_H */
@@ -19,15 +19,28 @@ enum
 	RX_STATS_HE_TRIGFLAG_LONG = (1 << 7)
 };
 
+// Per CPU counters of vif and station, updated with BH disabled
+struct rs_net_pcpu_stats __percpu *rs_net_stats_pcpu_alloc(void);
+void rs_net_stats_pcpu_free(struct rs_net_pcpu_stats __percpu *pcpu);
+void rs_net_stats_pcpu_reset(struct rs_net_pcpu_stats __percpu *pcpu);
+void rs_net_stats_rx(struct rs_net_pcpu_stats __percpu *pcpu, u32 len, bool mcast);
+void rs_net_stats_rx_drop(struct rs_net_pcpu_stats __percpu *pcpu);
+void rs_net_stats_tx(struct rs_net_pcpu_stats __percpu *pcpu, u32 len, bool sent);
+// Add counters of all CPUs to stats
+void rs_net_stats_pcpu_sum(struct rs_net_pcpu_stats __percpu *pcpu, struct rtnl_link_stats64 *stats);
+
+// Counters of station table entries, they live as long as net_priv
+rs_ret rs_net_stats_sta_init(struct rs_net_cfg80211_priv *net_priv);
+void rs_net_stats_sta_deinit(struct rs_net_cfg80211_priv *net_priv);
+
 #ifdef CONFIG_DBG_STATS
-void rs_net_rx_status_update(struct rs_net_cfg80211_priv *net_priv, struct rs_net_sta_stats *stats);
+void rs_net_rx_status_update(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_ext_hdr *last_rx);
 int rs_net_stats_init(struct rs_net_cfg80211_priv *net_priv);
 int rs_net_stats_deinit(struct rs_net_cfg80211_priv *net_priv);
 #else
 static inline void rs_net_rx_status_update(struct rs_net_cfg80211_priv *net_priv,
-					   struct rs_net_sta_stats *stats)
+					   struct rs_c_rx_ext_hdr *last_rx)
 {
-	return 0;
 }
 static inline int rs_net_stats_init(struct rs_net_cfg80211_priv *net_priv)
 {
@@ -30,4 +30,9 @@ rs_ret rs_net_tx_data(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, u8
 rs_ret rs_net_tx_mgmt(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, struct rs_net_sta_priv *sta,
 		      void *params, bool offchan, u64 *cookie);
 
+#ifdef CONFIG_RS_SELFTEST
+// Self-test, frame turned into A-MSDU subframe comes back the same through RX A-MSDU split
+rs_ret rs_net_tx_data_amsdu_selftest(struct rs_c_if *c_if);
+#endif
+
 #endif /* RS_NET_TX_DATA_H */
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+#ifndef RS_NET_XDP_H
+#define RS_NET_XDP_H
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include "rs_type.h"
+#include "rs_c_data.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+// Register RX queue info of opened vif
+rs_ret rs_net_xdp_open(struct rs_net_cfg80211_priv *net_priv, struct rs_net_vif_priv *vif_priv);
+
+// Unregister RX queue info of closed vif
+void rs_net_xdp_close(struct rs_net_vif_priv *vif_priv);
+
+// Run XDP program of vif on data frame in RX buffer, ext_hdr must be copied before as head may be grown
+// RS_SUCCESS if frame goes on to network stack, in *skb if program passed it or to be built if NULL,
+// otherwise frame was dropped, sent or redirected, *taken is set if RX buffer went with it
+rs_ret rs_net_xdp_rx(struct rs_net_cfg80211_priv *net_priv, struct rs_net_vif_priv *vif_priv,
+		     struct rs_c_rx_data *rx_data, u8 **skb, bool *taken);
+
+// Flush XDP_REDIRECT frames at end of poll of RX NAPI
+void rs_net_xdp_flush(struct rs_net_rx_napi *rx_napi);
+
+// ndo_bpf, attach or detach XDP program
+int rs_net_xdp_bpf(struct net_device *ndev, struct netdev_bpf *bpf);
+
+// ndo_xdp_xmit, send XDP frames redirected to this netdev
+int rs_net_xdp_xmit(struct net_device *ndev, int n, struct xdp_frame **frames, u32 flags);
+
+#endif /* RS_NET_XDP_H */
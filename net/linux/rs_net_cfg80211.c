@@ -23,6 +23,7 @@
 #include "rs_c_if.h"
 // #include "rs_c_status.h"
 #include "rs_c_ctrl.h"
+#include "rs_c_tx.h"
 
 #include "rs_core.h"
 #include "rs_net_params.h"
@@ -33,6 +34,8 @@
 #include "rs_net_ctrl.h"
 
 #include "rs_net_tx_data.h"
+#include "rs_net_rx_data.h"
+#include "rs_net_rx_reorder.h"
 
 #ifdef CONFIG_DEBUG_FS
 #include "rs_net_dbgfs.h"
@@ -51,6 +54,11 @@
 #define NET_DEFAULT_MAC_ADDR	"\xd4\x3d\x39"
 #define NET_MAC_ADDR_LEN	(17)
 
+// scan is split while data was seen this recently, channels per chunk and rest on channel between
+#define NET_SCAN_ACTIVE_MS	(1000)
+#define NET_SCAN_CHUNK_CH	(3)
+#define NET_SCAN_CHUNK_REST_MS	(30)
+
 #define RATE(_bitrate, _hw_rate, _flags) \
 	{                                \
 		.bitrate = (_bitrate),   \
@@ -850,17 +858,21 @@ static int net_station_info_fill(struct rs_net_sta_priv *sta, struct station_inf
 				 struct rs_net_vif_priv *vif_priv)
 {
 	struct rs_net_sta_stats *stats = &sta->stats;
-	struct net_device *ndev = rs_vif_priv_get_ndev(vif_priv);
+	struct rtnl_link_stats64 sta_stats = { 0 };
 	u16 format_mod = 0;
 
 	// Generic info
 	sinfo->generation = vif_priv->generation;
 
+	rs_net_stats_pcpu_sum(stats->pcpu, &sta_stats);
+
 	sinfo->inactive_time = jiffies_to_msecs(jiffies - stats->last_acttive_time);
-	sinfo->rx_bytes = ndev->stats.rx_bytes;
-	sinfo->rx_packets = ndev->stats.rx_packets;
-	sinfo->tx_bytes = ndev->stats.tx_bytes;
-	sinfo->tx_packets = ndev->stats.tx_packets;
+	sinfo->rx_bytes = sta_stats.rx_bytes;
+	sinfo->rx_packets = sta_stats.rx_packets;
+	sinfo->rx_dropped_misc = sta_stats.rx_dropped;
+	sinfo->tx_bytes = sta_stats.tx_bytes;
+	sinfo->tx_packets = sta_stats.tx_packets;
+	sinfo->tx_failed = sta_stats.tx_dropped;
 
 	sinfo->signal = stats->last_rx_data_ext.rssi1;
 
@@ -934,7 +946,8 @@ static int net_station_info_fill(struct rs_net_sta_priv *sta, struct station_inf
 	sinfo->filled = (BIT(NL80211_STA_INFO_INACTIVE_TIME) | BIT(NL80211_STA_INFO_RX_BYTES64) |
 			 BIT(NL80211_STA_INFO_TX_BYTES64) | BIT(NL80211_STA_INFO_RX_PACKETS) |
 			 BIT(NL80211_STA_INFO_TX_PACKETS) | BIT(NL80211_STA_INFO_SIGNAL) |
-			 BIT(NL80211_STA_INFO_RX_BITRATE));
+			 BIT(NL80211_STA_INFO_RX_BITRATE) | BIT(NL80211_STA_INFO_RX_DROP_MISC) |
+			 BIT(NL80211_STA_INFO_TX_FAILED));
 
 	return 0;
 }
@@ -1023,6 +1036,9 @@ static s32 net_del_station(struct rs_c_if *c_if, struct rs_net_cfg80211_priv *ne
 				}
 			}
 
+			(void)rs_c_tx_set_sta_amsdu(c_if, cur->sta_idx, 0);
+			rs_net_rx_reorder_sta_reset(net_priv, cur->sta_idx);
+
 			ret = rs_net_ctrl_del_station_req(c_if, cur->sta_idx, FALSE);
 			if (ret != RS_SUCCESS) {
 				found = -EPIPE;
@@ -1352,6 +1368,63 @@ static int net_cfg80211_change_virtual_iface(struct wiphy *wiphy, struct net_dev
 	return ret;
 }
 
+// Data traffic seen recently on any station, or queued for TX
+static bool net_cfg80211_data_active(struct rs_c_if *c_if, struct rs_net_cfg80211_priv *net_priv)
+{
+	bool active = FALSE;
+	struct rs_net_sta_priv *sta = NULL;
+	unsigned long active_time = msecs_to_jiffies(NET_SCAN_ACTIVE_MS);
+	u16 i = 0;
+	u8 lane = 0;
+
+	for (i = 0; (i < RS_NET_PRIV_STA_TABLE_MAX) && (active == FALSE); i++) {
+		sta = &net_priv->sta_table[i];
+		if ((sta->valid == true) &&
+		    time_before(jiffies, sta->stats.last_acttive_time + active_time)) {
+			active = TRUE;
+		}
+	}
+
+	for (lane = 0; (lane < RS_C_TX_LANE_MAX) && (active == FALSE); lane++) {
+		if (rs_c_tx_lane_count(c_if, lane) > 0) {
+			active = TRUE;
+		}
+	}
+
+	return active;
+}
+
+// Start next channel chunk of scan request
+static rs_ret net_cfg80211_scan_chunk_start(struct rs_c_if *c_if, struct rs_net_cfg80211_priv *net_priv)
+{
+	rs_ret ret = RS_FAIL;
+	struct cfg80211_scan_request *request = net_priv->scan_request;
+	u16 ch_start = net_priv->scan_chunk.next;
+
+	if (request && (net_priv->scan_chunk.abort == FALSE) && (ch_start < request->n_channels)) {
+		net_priv->scan_chunk.next =
+			min_t(u16, ch_start + net_priv->scan_chunk.chunk, request->n_channels);
+
+		ret = rs_net_ctrl_scan_start(c_if, request, ch_start, net_priv->scan_chunk.chunk);
+	}
+
+	return ret;
+}
+
+static void net_cfg80211_scan_chunk_work(struct work_struct *work)
+{
+	struct rs_net_cfg80211_priv *net_priv = NULL;
+	struct rs_c_if *c_if = NULL;
+
+	net_priv = container_of(work, struct rs_net_cfg80211_priv, scan_chunk.work.work);
+	c_if = rs_net_priv_get_c_if(net_priv);
+
+	if (c_if && (net_cfg80211_scan_chunk_start(c_if, net_priv) != RS_SUCCESS)) {
+		net_priv->scan_chunk.abort = TRUE;
+		(void)rs_net_cfg80211_scan_done(c_if);
+	}
+}
+
 static int net_cfg80211_scan(struct wiphy *wiphy, struct cfg80211_scan_request *request)
 {
 	s32 ret = 0;
@@ -1377,11 +1450,21 @@ static int net_cfg80211_scan(struct wiphy *wiphy, struct cfg80211_scan_request *
 		return -EAGAIN;
 	}
 
-	ret = rs_net_ctrl_scan_start(c_if, request);
+	// firmware leaves the operating channel for the whole request, keep it short under traffic
+	net_priv->scan_chunk.abort = FALSE;
+	net_priv->scan_chunk.next = 0;
+	net_priv->scan_chunk.chunk = RS_C_SCAN_CHANNEL_MAX;
+	if (net_cfg80211_data_active(c_if, net_priv) == TRUE) {
+		net_priv->scan_chunk.chunk = NET_SCAN_CHUNK_CH;
+	}
+
+	net_priv->scan_request = request;
+	ret = net_cfg80211_scan_chunk_start(c_if, net_priv);
 
 	if (ret == RS_SUCCESS) {
-		net_priv->scan_request = request;
 		c_if->core->scan = 1;
+	} else {
+		net_priv->scan_request = NULL;
 	}
 
 	return ret;
@@ -1400,7 +1483,11 @@ static void net_cfg80211_scan_abort(struct wiphy *wiphy, struct wireless_dev *wd
 
 	if ((wdev) && (c_if) && (net_priv) && (net_priv->scan_request)) {
 		vif_priv = container_of(wdev, struct rs_net_vif_priv, wdev);
-		if (vif_priv->up) {
+		net_priv->scan_chunk.abort = TRUE;
+		if (cancel_delayed_work_sync(&net_priv->scan_chunk.work)) {
+			// between chunks, no scan is running in firmware
+			(void)rs_net_cfg80211_scan_done(c_if);
+		} else if (vif_priv->up) {
 			(void)rs_net_ctrl_scan_cancel(c_if, vif_priv);
 		}
 		c_if->core->scan = 0;
@@ -1802,6 +1889,12 @@ static int net_cfg80211_add_station(struct wiphy *wiphy, struct net_device *ndev
 			sta->acm = 0;
 			sta->listen_interval = params->listen_interval;
 			rs_k_memcpy(sta->mac_addr, mac, ETH_ADDR_LEN);
+			// HT station takes A-MSDUs of 3839 bytes at least, above host limit
+			(void)rs_c_tx_set_sta_amsdu(c_if, sta->sta_idx,
+						    (sta->qos && sta->ht) ? RS_C_TX_AMSDU_LEN : 0);
+			// table entry may be reused, nothing of former station is held
+			rs_net_rx_reorder_sta_reset(net_priv, sta->sta_idx);
+			rs_net_stats_pcpu_reset(sta->stats.pcpu);
 			// spin_lock_bh(&net_priv->cb_lock); //TODO
 			list_add_tail(&sta->list, &vif_priv->ap.sta_list);
 			vif_priv->generation++;
@@ -3362,6 +3455,14 @@ rs_ret rs_net_cfg80211_init(struct rs_c_if *c_if)
 			}
 
 			INIT_LIST_HEAD(&net_priv->vifs);
+			INIT_DELAYED_WORK(&net_priv->scan_chunk.work, net_cfg80211_scan_chunk_work);
+
+			// station table index is sta_idx
+			for (i = 0; i < RS_NET_PRIV_STA_TABLE_MAX; i++) {
+				net_priv->sta_table[i].txq = rs_c_tx_get_txq(c_if, i, 0);
+			}
+
+			ret = rs_net_stats_sta_init(net_priv);
 
 			net_priv->roc = NULL;
 
@@ -3375,6 +3476,12 @@ rs_ret rs_net_cfg80211_init(struct rs_c_if *c_if)
 			net_priv->ext_capa[8] = WLAN_EXT_CAPA9_MAX_MSDU_IN_AMSDU_MSB;
 		}
 
+#ifdef CONFIG_RS_NAPI
+		if (ret == RS_SUCCESS) {
+			ret = rs_net_rx_napi_init(c_if);
+		}
+#endif
+
 		if (ret == RS_SUCCESS) {
 			/// Set parameter to F/W
 			ret = rs_net_ctrl_dev_reset(c_if);
@@ -3384,6 +3491,15 @@ rs_ret rs_net_cfg80211_init(struct rs_c_if *c_if)
 			ret = rs_net_ctrl_get_fw_ver(c_if, &net_priv->cmd_rsp.fw_ver);
 		}
 
+		if (ret == RS_SUCCESS) {
+			// RX aggregation is optional, F/W keeps sending single frames without it
+			(void)rs_net_ctrl_if_capa(c_if, &net_priv->cmd_rsp.fw_ver);
+		}
+
+		if (ret == RS_SUCCESS) {
+			ret = rs_net_rx_reorder_init(net_priv);
+		}
+
 		if (ret == RS_SUCCESS) {
 			/// Set wiphy
 			ret = net_cfg80211_set_default_wiphy(c_if, wiphy);
@@ -3452,6 +3568,11 @@ rs_ret rs_net_cfg80211_init(struct rs_c_if *c_if)
 	}
 
 	if (ret != RS_SUCCESS) {
+#ifdef CONFIG_RS_NAPI
+		(void)rs_net_rx_napi_deinit(c_if);
+#endif
+		(void)rs_net_rx_reorder_deinit(net_priv);
+		rs_net_stats_sta_deinit(net_priv);
 		wiphy_free(wiphy);
 		(void)rs_net_priv_set_wiphy(net_priv, NULL);
 		(void)rs_c_if_set_net_priv(c_if, NULL);
@@ -3472,6 +3593,16 @@ rs_ret rs_net_cfg80211_deinit(struct rs_c_if *c_if)
 	wiphy = rs_net_priv_get_wiphy(net_priv);
 
 	if ((net_priv) && (wiphy)) {
+		net_priv->scan_chunk.abort = TRUE;
+		(void)cancel_delayed_work_sync(&net_priv->scan_chunk.work);
+
+#ifdef CONFIG_RS_NAPI
+		// RX data left in core queue is freed by core
+		(void)rs_net_rx_napi_deinit(c_if);
+#endif
+		// frames held for reordering are freed with their windows
+		(void)rs_net_rx_reorder_deinit(net_priv);
+
 		(void)net_vif_del_all(net_priv);
 
 #ifdef CONFIG_DEBUG_FS
@@ -3479,6 +3610,8 @@ rs_ret rs_net_cfg80211_deinit(struct rs_c_if *c_if)
 #endif
 
 		(void)wiphy_unregister(wiphy);
+		// station counters are in net_priv, freed with wiphy
+		rs_net_stats_sta_deinit(net_priv);
 		(void)wiphy_free(wiphy);
 
 		rs_net_dfs_detection_deinit(&net_priv->dfs);
@@ -3614,12 +3747,19 @@ void rs_net_cfg80211_gcmp_enable(struct wiphy *wiphy)
 rs_ret rs_net_cfg80211_scan_done(struct rs_c_if *c_if)
 {
 	struct rs_net_cfg80211_priv *net_priv = NULL;
+	bool next_chunk = FALSE;
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
 	net_priv = (struct rs_net_cfg80211_priv *)rs_c_if_get_net_priv(c_if);
 	if (net_priv != NULL) {
-		if (net_priv->scan_request) {
+		if ((net_priv->scan_request) && (net_priv->scan_chunk.abort == FALSE) &&
+		    (net_priv->scan_chunk.next < net_priv->scan_request->n_channels)) {
+			// back on operating channel for a while, then next chunk
+			schedule_delayed_work(&net_priv->scan_chunk.work,
+					      msecs_to_jiffies(NET_SCAN_CHUNK_REST_MS));
+			next_chunk = TRUE;
+		} else if (net_priv->scan_request) {
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 8, 0)
 			struct cfg80211_scan_info info = {
 				.aborted = false,
@@ -3631,10 +3771,14 @@ rs_ret rs_net_cfg80211_scan_done(struct rs_c_if *c_if)
 #endif
 		}
 
-		net_priv->scan_request = NULL;
+		if (next_chunk == FALSE) {
+			net_priv->scan_request = NULL;
+		}
 	}
 
-	c_if->core->scan = 0;
+	if (next_chunk == FALSE) {
+		c_if->core->scan = 0;
+	}
 
 	return 0;
 }
@@ -3649,10 +3793,14 @@ rs_ret rs_net_cfg80211_scan_stop_and_wait(struct rs_c_if *c_if, struct rs_net_vi
 
 	if ((c_if != NULL) && (net_priv != NULL) && (vif_priv != NULL) && (net_priv->scan_request != NULL) &&
 	    (rs_net_vif_is_up(vif_priv) == RS_SUCCESS)) {
-		(void)rs_net_ctrl_scan_cancel(c_if, vif_priv);
-		while ((net_priv->scan_request != NULL) && (count > 0)) {
-			msleep(10);
-			count--;
+		net_priv->scan_chunk.abort = TRUE;
+		// pending between chunks, no scan is running in firmware
+		if (cancel_delayed_work_sync(&net_priv->scan_chunk.work) == false) {
+			(void)rs_net_ctrl_scan_cancel(c_if, vif_priv);
+			while ((net_priv->scan_request != NULL) && (count > 0)) {
+				msleep(10);
+				count--;
+			}
 		}
 
 		(void)rs_net_cfg80211_scan_done(c_if);
@@ -19,12 +19,14 @@
 #include "rs_c_cmd.h"
 #include "rs_c_data.h"
 #include "rs_c_ctrl.h"
+#include "rs_c_rx.h"
 #include "rs_core.h"
 
 #include "rs_net_cfg80211.h"
 #include "rs_net_priv.h"
 #include "rs_net_dev.h"
 #include "rs_net_params.h"
+#include "rs_net_rx_reorder.h"
 
 #include "rs_net_ctrl.h"
 
@@ -34,6 +36,10 @@
 // Assume that rate higher that 54 Mbps are BSS membership
 #define IS_BASIC_RATE(r) (r & 0x80) && ((r & ~0x80) <= (54 * 2))
 
+// IF capabilities host takes
+#define NET_CTRL_IF_CAPA_HOST \
+	(RS_C_IF_CAPA_RX_AGG | RS_C_IF_CAPA_TX_AGG | RS_C_IF_CAPA_TX_AMSDU | RS_C_IF_CAPA_RX_REORDER)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -207,8 +213,11 @@ rs_ret rs_net_ctrl_get_fw_ver(struct rs_c_if *c_if, struct rs_c_fw_ver_rsp *rsp_
 		if (ret == RS_SUCCESS) {
 			if (ctrl_rsp_data->cmd == cmd_id) {
 				if (rsp_data) {
+					// older F/W answers without IF capability fields
+					(void)rs_k_memset(rsp_data, 0, sizeof(struct rs_c_fw_ver_rsp));
 					(void)rs_k_memcpy(rsp_data, ctrl_rsp_data->data,
-							  sizeof(struct rs_c_fw_ver_rsp));
+							  min_t(u16, ctrl_rsp_data->data_len,
+								sizeof(struct rs_c_fw_ver_rsp)));
 				} else {
 					ret = RS_FAIL;
 				}
@@ -223,6 +232,87 @@ rs_ret rs_net_ctrl_get_fw_ver(struct rs_c_if *c_if, struct rs_c_fw_ver_rsp *rsp_
 	return ret;
 }
 
+rs_ret rs_net_ctrl_if_capa(struct rs_c_if *c_if, struct rs_c_fw_ver_rsp *fw_ver)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_if_capa_req req_data = { 0 };
+	struct rs_c_if_capa_rsp *rsp_data = NULL;
+	struct rs_c_ctrl_rsp *ctrl_rsp_data = NULL;
+	u8 cmd_id = RS_DEV_IF_CAPA_CMD;
+
+	RS_TRACE(RS_FN_ENTRY_STR);
+
+	if (c_if && c_if->core && fw_ver) {
+		c_if->core->rx.if_capa = 0;
+		(void)rs_c_tx_set_agg(c_if, 0, 0);
+		(void)rs_c_tx_set_amsdu(c_if, 0, 0);
+
+		// F/W not knowing the command would time out and go to recovery, none shared is plain I/F
+		if ((fw_ver->if_capa_ver < RS_C_IF_CAPA_VER) ||
+		    ((fw_ver->if_capa & NET_CTRL_IF_CAPA_HOST) == 0)) {
+			ret = RS_NOT_SUPPORT;
+		} else {
+			ctrl_rsp_data = rs_k_calloc(sizeof(struct rs_c_ctrl_rsp));
+		}
+	}
+
+	if (ctrl_rsp_data) {
+		// aggregated read goes to RX buffer like any other frame
+		req_data.capa = fw_ver->if_capa & NET_CTRL_IF_CAPA_HOST;
+		req_data.rx_agg_len = RS_C_RX_BUF_SIZE;
+		req_data.tx_agg_len = RS_C_TX_AGG_LEN;
+		req_data.tx_agg_num = RS_C_TX_AGG_NUM_MAX;
+		req_data.tx_amsdu_len = RS_C_TX_AMSDU_LEN;
+		req_data.tx_amsdu_num = RS_C_TX_AMSDU_NUM_MAX;
+		// HE sessions take up to 256 MPDUs, MPDU beyond host window would flush held ones early
+		req_data.rx_reorder_win = RS_NET_RX_REORDER_WIN;
+
+		ret = rs_c_ctrl_set_and_wait(c_if, cmd_id, sizeof(struct rs_c_if_capa_req), (u8 *)&req_data,
+					     ctrl_rsp_data);
+		if (ret == RS_SUCCESS) {
+			if ((ctrl_rsp_data->cmd == cmd_id) &&
+			    (ctrl_rsp_data->data_len >= sizeof(struct rs_c_if_capa_rsp))) {
+				rsp_data = (struct rs_c_if_capa_rsp *)ctrl_rsp_data->data;
+				c_if->core->rx.if_capa = rsp_data->capa & req_data.capa;
+
+				if (c_if->core->rx.if_capa & RS_C_IF_CAPA_TX_AGG) {
+					// F/W limit of 0 takes host limit
+					if (rsp_data->tx_agg_len == 0) {
+						rsp_data->tx_agg_len = req_data.tx_agg_len;
+					}
+					if (rsp_data->tx_agg_num == 0) {
+						rsp_data->tx_agg_num = req_data.tx_agg_num;
+					}
+					(void)rs_c_tx_set_agg(c_if, rsp_data->tx_agg_len,
+							      rsp_data->tx_agg_num);
+				}
+
+				if (c_if->core->rx.if_capa & RS_C_IF_CAPA_TX_AMSDU) {
+					if (rsp_data->tx_amsdu_len == 0) {
+						rsp_data->tx_amsdu_len = req_data.tx_amsdu_len;
+					}
+					if (rsp_data->tx_amsdu_num == 0) {
+						rsp_data->tx_amsdu_num = req_data.tx_amsdu_num;
+					}
+					(void)rs_c_tx_set_amsdu(c_if, rsp_data->tx_amsdu_len,
+								rsp_data->tx_amsdu_num);
+				}
+			} else {
+				ret = RS_FAIL;
+			}
+		}
+
+		RS_INFO("IF capa ver[%u]:fw[0x%x]:on[0x%x]\n", fw_ver->if_capa_ver, fw_ver->if_capa,
+			c_if->core->rx.if_capa);
+	}
+
+	if (ctrl_rsp_data) {
+		rs_k_free(ctrl_rsp_data);
+	}
+
+	return ret;
+}
+
 rs_ret rs_net_ctrl_if_add(struct rs_c_if *c_if, const u8 *mac_addr, u8 iftype, bool p2p,
 			  struct rs_c_add_if_rsp *rsp_data)
 {
@@ -533,7 +623,8 @@ rs_ret rs_net_ctrl_me_chan_config(struct rs_c_if *c_if)
 	return ret;
 }
 
-rs_ret rs_net_ctrl_scan_start(struct rs_c_if *c_if, struct cfg80211_scan_request *param)
+rs_ret rs_net_ctrl_scan_start(struct rs_c_if *c_if, struct cfg80211_scan_request *param, u16 ch_start,
+			      u16 ch_num)
 {
 	rs_ret ret = RS_FAIL;
 	struct rs_net_cfg80211_priv *net_priv = NULL;
@@ -552,11 +643,13 @@ rs_ret rs_net_ctrl_scan_start(struct rs_c_if *c_if, struct cfg80211_scan_request
 	vif_priv = container_of(param->wdev, struct rs_net_vif_priv, wdev);
 	req_data = rs_k_calloc(req_data_len);
 
-	if ((c_if) && (net_priv)) {
+	if ((c_if) && (net_priv) && (req_data) && (ch_start < param->n_channels)) {
 		(void)rs_k_memcpy(req_data->bssid, mac_addr, ETH_ALEN);
 
+		ch_num = min_t(u16, ch_num, param->n_channels - ch_start);
+
 		req_data->vif_idx = vif_priv->vif_index;
-		req_data->n_channels = (u8)min_t(int, RS_C_SCAN_CHANNEL_MAX, param->n_channels);
+		req_data->n_channels = (u8)min_t(int, RS_C_SCAN_CHANNEL_MAX, ch_num);
 		req_data->n_ssids = (u8)min_t(int, RS_C_SCAN_SSID_MAX, param->n_ssids);
 		req_data->no_cck = param->no_cck;
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 8, 0)
@@ -582,7 +675,7 @@ rs_ret rs_net_ctrl_scan_start(struct rs_c_if *c_if, struct cfg80211_scan_request
 		}
 
 		for (i = 0; i < req_data->n_channels; i++) {
-			struct ieee80211_channel *chan = param->channels[i];
+			struct ieee80211_channel *chan = param->channels[ch_start + i];
 
 			req_data->chan[i].ch_band = chan->band;
 			req_data->chan[i].ch_freq = chan->center_freq;
@@ -1896,3 +1989,49 @@ rs_ret rs_net_ctrl_dbg_stats_tx_req(struct rs_c_if *c_if, u8 req, struct rs_c_db
 	return ret;
 }
 #endif
+
+#ifdef CONFIG_RS_SELFTEST
+rs_ret rs_net_ctrl_if_capa_selftest(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_if *mock_if = NULL;
+	struct rs_c_fw_ver_rsp fw_ver = { 0 };
+	u8 test = 0;
+
+	// mock I/F has no bus, handshake falling back sends no command to it
+	mock_if = rs_k_calloc(sizeof(struct rs_c_if));
+	if (c_if && mock_if) {
+		mock_if->core = rs_k_calloc(sizeof(struct rs_core));
+	}
+
+	if (mock_if && mock_if->core) {
+		ret = RS_SUCCESS;
+		for (test = 0; (test < 2) && (ret == RS_SUCCESS); test++) {
+			// capabilities of previous F/W are dropped
+			mock_if->core->rx.if_capa = NET_CTRL_IF_CAPA_HOST;
+			(void)rs_c_tx_set_agg(mock_if, RS_C_TX_AGG_LEN, RS_C_TX_AGG_NUM_MAX);
+			(void)rs_c_tx_set_amsdu(mock_if, RS_C_TX_AMSDU_LEN, RS_C_TX_AMSDU_NUM_MAX);
+
+			// F/W of older handshake version, then F/W advertising no capability
+			fw_ver.if_capa_ver = (test == 0) ? (RS_C_IF_CAPA_VER - 1) : RS_C_IF_CAPA_VER;
+			fw_ver.if_capa = (test == 0) ? NET_CTRL_IF_CAPA_HOST : 0;
+
+			if ((rs_net_ctrl_if_capa(mock_if, &fw_ver) != RS_NOT_SUPPORT) ||
+			    (mock_if->core->rx.if_capa != 0) || (mock_if->core->tx_data.agg_num != 0) ||
+			    (mock_if->core->tx_data.amsdu_num != 0)) {
+				RS_ERR("if capa selftest [%u]:capa[0x%x]\n", test, mock_if->core->rx.if_capa);
+				ret = RS_FAIL;
+			}
+		}
+	}
+
+	if (mock_if) {
+		if (mock_if->core) {
+			rs_k_free(mock_if->core);
+		}
+		rs_k_free(mock_if);
+	}
+
+	return ret;
+}
+#endif
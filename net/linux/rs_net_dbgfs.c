@@ -12,19 +12,36 @@
 #include <linux/version.h>
 #include <linux/module.h>
 #include <net/cfg80211.h>
+#ifdef CONFIG_RS_Q_BENCH
+#include <linux/kthread.h>
+#include <linux/completion.h>
+#include <linux/ktime.h>
+#endif
 
 #include "rs_type.h"
 #include "rs_k_mem.h"
+#include "rs_k_spin_lock.h"
 #include "rs_c_if.h"
 #include "rs_core.h"
 #include "rs_c_cmd.h"
 #include "rs_c_dbg.h"
+#include "rs_c_tx.h"
+#include "rs_c_status.h"
+#include "rs_c_q.h"
+#include "rs_c_ring.h"
+#ifdef CONFIG_RS_SELFTEST
+#include "rs_c_rx.h"
+#endif
 
 #include "rs_net_cfg80211.h"
 #include "rs_net_priv.h"
 #include "rs_net_dev.h"
 
 #include "rs_net_ctrl.h"
+#include "rs_net_rx_reorder.h"
+#ifdef CONFIG_RS_SELFTEST
+#include "rs_net_tx_data.h"
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
@@ -73,14 +90,64 @@
 		.llseek = generic_file_llseek,                        \
 	};
 
+#ifdef CONFIG_RS_Q_BENCH
+#define RS_DBGFS_Q_BENCH_DEPTH	 (64)
+#define RS_DBGFS_Q_BENCH_DEF_CNT (1000000)
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
+#ifdef CONFIG_RS_Q_BENCH
+// Two thread queue benchmark, producer kthread and consumer in debugfs writer
+struct rs_dbgfs_q_bench {
+	bool use_ring;
+	u32 count;
+
+	// rs_c_q + spin lock, as used before SPSC ring
+	struct rs_q q;
+	struct rs_k_spin_lock lock;
+
+	struct rs_c_ring ring;
+
+	void *buf[RS_DBGFS_Q_BENCH_DEPTH];
+	struct completion done;
+};
+#endif
+
+#ifdef CONFIG_RS_SELFTEST
+// Self-test run by write to selftest file
+struct rs_dbgfs_selftest {
+	const char *name;
+	rs_ret (*run)(struct rs_c_if *c_if);
+};
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
 
 static struct dentry *root_dir;
 
+#ifdef CONFIG_RS_Q_BENCH
+static struct {
+	u32 count;
+	u64 q_ns;
+	u64 ring_ns;
+} q_bench_result;
+#endif
+
+#ifdef CONFIG_RS_SELFTEST
+static const struct rs_dbgfs_selftest selftest_table[] = {
+	{ "tx_amsdu_sub", rs_net_tx_data_amsdu_selftest },
+	{ "rx_agg", rs_c_rx_agg_selftest },
+	{ "if_capa", rs_net_ctrl_if_capa_selftest },
+};
+
+// result of last run
+static rs_ret selftest_result[ARRAY_SIZE(selftest_table)];
+static bool selftest_done;
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
@@ -96,8 +163,8 @@ static ssize_t rs_dbgfs_stats_read(struct file *file, char __user *user_buf, siz
 	if (!buf)
 		return -ENOMEM;
 
-	len += scnprintf(buf + len, buf_len - len, "Tx: sent %u if_err %u\n", rs_c_dbg_stat.tx.nb_sent,
-			 rs_c_dbg_stat.tx.nb_if_err);
+	len += scnprintf(buf + len, buf_len - len, "Tx: sent %u if_err %u\n",
+			 RS_C_DBG_STAT_SUM(tx.nb_sent), RS_C_DBG_STAT_SUM(tx.nb_if_err));
 
 	// len += scnprintf(buf + len, buf_len - len, "\n HW Queue     ");
 	// for (i = 0; i < RS_TXQ_CNT; i++) {
@@ -140,8 +207,13 @@ static ssize_t rs_dbgfs_stats_read(struct file *file, char __user *user_buf, siz
 
 	/************************************************************************/
 
-	len += scnprintf(buf + len, buf_len - len, "\nRx: recv %u, err len %d\n", rs_c_dbg_stat.rx.nb_recv,
-			 rs_c_dbg_stat.rx.nb_err_len);
+	len += scnprintf(buf + len, buf_len - len, "\nRx: recv %u, err len %d\n",
+			 RS_C_DBG_STAT_SUM(rx.nb_recv), RS_C_DBG_STAT_SUM(rx.nb_err_len));
+	len += scnprintf(buf + len, buf_len - len, "    amsdu %u, subframe %u\n",
+			 RS_C_DBG_STAT_SUM(rx.nb_amsdu), RS_C_DBG_STAT_SUM(rx.nb_amsdu_sub));
+	len += scnprintf(buf + len, buf_len - len, "    mgmt %u, inline %u, data drop %u\n",
+			 RS_C_DBG_STAT_SUM(rx.nb_mgmt), RS_C_DBG_STAT_SUM(rx.nb_mgmt_inline),
+			 RS_C_DBG_STAT_SUM(rx.nb_drop));
 
 	// len += scnprintf(buf + len, buf_len - len,
 	//	" Status: forward %d other %d all %d\n",
@@ -160,6 +232,461 @@ static ssize_t rs_dbgfs_stats_read(struct file *file, char __user *user_buf, siz
 
 RS_DBGFS_OPS_RD(stats);
 
+static ssize_t rs_dbgfs_tx_ac_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	static const char *const lane_name[RS_C_TX_LANE_MAX] = { "VO", "VI", "BE", "BK" };
+	static const char *const ac_name[RS_IF_DATA_MAX] = { "DATA ", "POWER" };
+	char buf[512];
+	size_t len = 0;
+	u8 lane = 0;
+	u8 ac = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "AC  queued   sent       starve\n");
+	for (lane = 0; lane < RS_C_TX_LANE_MAX; lane++) {
+		len += scnprintf(buf + len, sizeof(buf) - len, "%s  %-8u %-10u %u\n", lane_name[lane],
+				 rs_c_tx_lane_count(c_if, lane), c_if->core->tx_data.lane_sent[lane],
+				 c_if->core->tx_data.lane_starve[lane]);
+	}
+	len += scnprintf(buf + len, sizeof(buf) - len, "kick %u defer %u timer %u\n",
+			 c_if->core->tx_data.kick_cnt, c_if->core->tx_data.kick_defer_cnt,
+			 c_if->core->tx_data.kick_timer_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "off_chan %u expire %u\n",
+			 c_if->core->tx_data.off_chan_cnt, c_if->core->tx_data.off_chan_expire_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "sg %u\n", c_if->core->tx_data.sg_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "agg %u/%u write %u frame %u\n",
+			 c_if->core->tx_data.agg_len, c_if->core->tx_data.agg_num,
+			 c_if->core->tx_data.agg_write_cnt, c_if->core->tx_data.agg_frame_cnt);
+	for (ac = 0; ac < RS_IF_DATA_MAX; ac++) {
+		len += scnprintf(buf + len, sizeof(buf) - len, "%s credit %d read %u stall %u\n",
+				 ac_name[ac], rs_c_status_tx_credit(c_if, ac),
+				 c_if->core->status.credit_read[ac], c_if->core->status.credit_stall[ac]);
+	}
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(tx_ac);
+
+static ssize_t rs_dbgfs_tx_aqm_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	char buf[256];
+	size_t len = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "codel_drop    %u\n", c_if->core->tx_data.codel_drop);
+	len += scnprintf(buf + len, sizeof(buf) - len, "codel_mark    %u\n", c_if->core->tx_data.codel_mark);
+	len += scnprintf(buf + len, sizeof(buf) - len, "lifetime_drop %u\n",
+			 c_if->core->tx_data.lifetime_drop);
+	len += scnprintf(buf + len, sizeof(buf) - len, "sojourn_us    p50<%u p90<%u p99<%u\n",
+			 rs_c_tx_sojourn_pct(c_if, 50), rs_c_tx_sojourn_pct(c_if, 90),
+			 rs_c_tx_sojourn_pct(c_if, 99));
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(tx_aqm);
+
+static ssize_t rs_dbgfs_tx_amsdu_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	struct rs_c_txq *txq = NULL;
+	char buf[512];
+	size_t len = 0;
+	u16 sta_idx = 0;
+	u8 i = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "amsdu %u/%u\n", c_if->core->tx_data.amsdu_len,
+			 c_if->core->tx_data.amsdu_num);
+	len += scnprintf(buf + len, sizeof(buf) - len, "sub   sent\n");
+	for (i = 0; i < RS_C_TX_AMSDU_NUM_MAX; i++) {
+		len += scnprintf(buf + len, sizeof(buf) - len, "%-5u %u\n", i + 1,
+				 c_if->core->tx_data.amsdu_hist[i]);
+	}
+	len += scnprintf(buf + len, sizeof(buf) - len, "sta  ");
+	for (sta_idx = 0; sta_idx < (c_if->core->tx_data.txq_num / RS_C_TX_TID_MAX); sta_idx++) {
+		txq = rs_c_tx_get_txq(c_if, sta_idx, 0);
+		if (txq && (txq->amsdu_len > 0)) {
+			len += scnprintf(buf + len, sizeof(buf) - len, " %u", sta_idx);
+		}
+	}
+	len += scnprintf(buf + len, sizeof(buf) - len, "\n");
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+// "<sta_idx> <0|1>" turns A-MSDU to station off or on
+static ssize_t rs_dbgfs_tx_amsdu_write(struct file *file, const char __user *user_buf, size_t count,
+				       loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	char buf[32];
+	size_t len = min_t(size_t, count, sizeof(buf) - 1);
+	u32 sta_idx = 0;
+	u32 on = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	if (copy_from_user(buf, user_buf, len))
+		return -EFAULT;
+	buf[len] = '\0';
+
+	if ((sscanf(buf, "%u %u", &sta_idx, &on) != 2) || (sta_idx > U8_MAX))
+		return -EINVAL;
+
+	if (rs_c_tx_set_sta_amsdu(c_if, sta_idx, (on != 0) ? RS_C_TX_AMSDU_LEN : 0) != RS_SUCCESS)
+		return -EINVAL;
+
+	return count;
+}
+
+RS_DBGFS_OPS_RW(tx_amsdu);
+
+static ssize_t rs_dbgfs_rx_pool_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	struct rs_c_pool *pool = NULL;
+	char buf[256];
+	size_t len = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	pool = &c_if->core->rx_pool;
+	len += scnprintf(buf + len, sizeof(buf) - len, "free    %u/%u min %u low %u\n", pool->free_count,
+			 pool->own_num, pool->min_free, pool->low_mark);
+	len += scnprintf(buf + len, sizeof(buf) - len, "get     %u\n", pool->get_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "refill  %u\n", pool->refill_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "exhaust %u\n", pool->exhaust_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "detach  %u\n", pool->detach_cnt);
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(rx_pool);
+
+static ssize_t rs_dbgfs_rx_agg_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	char buf[128];
+	size_t len = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "capa    0x%x\n", c_if->core->rx.if_capa);
+	len += scnprintf(buf + len, sizeof(buf) - len, "read    %u\n", c_if->core->rx.agg_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "record  %u\n", c_if->core->rx.agg_rec_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "error   %u\n", c_if->core->rx.agg_err_cnt);
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(rx_agg);
+
+static ssize_t rs_dbgfs_rx_reorder_read(struct file *file, char __user *user_buf, size_t count,
+					loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_net_rx_reorder_stats stats = { 0 };
+	char buf[128];
+	size_t len = 0;
+	bool on = FALSE;
+
+	on = rs_net_rx_reorder_get_stats(net_priv, &stats);
+	len += scnprintf(buf + len, sizeof(buf) - len, "on      %u\n", on ? 1 : 0);
+	len += scnprintf(buf + len, sizeof(buf) - len, "held    %u\n", stats.held_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "dup     %u\n", stats.dup_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "old     %u\n", stats.old_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "timeout %u\n", stats.timeout_cnt);
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(rx_reorder);
+
+static ssize_t rs_dbgfs_bus_hs_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	struct rs_c_if_hs_stats hs_stats = { 0 };
+	char buf[512];
+	size_t len = 0;
+	u8 i = 0;
+
+	if (rs_c_if_get_hs_stats(c_if, &hs_stats) != RS_SUCCESS)
+		return -EOPNOTSUPP;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "spin    %u\n", hs_stats.spin_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "sleep   %u\n", hs_stats.sleep_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "timeout %u\n", hs_stats.timeout_cnt);
+	len += scnprintf(buf + len, sizeof(buf) - len, "spin_us %u\n", hs_stats.spin_us);
+	len += scnprintf(buf + len, sizeof(buf) - len, "latency_us count\n");
+	for (i = 0; i < (RS_C_IF_HS_HIST_NUM - 1); i++) {
+		len += scnprintf(buf + len, sizeof(buf) - len, "<%-9u %u\n", 1U << i, hs_stats.hist[i]);
+	}
+	len += scnprintf(buf + len, sizeof(buf) - len, ">=%-8u %u\n", 1U << (i - 1), hs_stats.hist[i]);
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(bus_hs);
+
+#ifdef CONFIG_RS_NAPI
+static ssize_t rs_dbgfs_rx_queue_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_net_rx_napi *rx_napi = NULL;
+	char buf[512];
+	size_t len = 0;
+	u8 i = 0;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "q cpu poll frame ipi\n");
+	for (i = 0; i < net_priv->rx_napi.q_num; i++) {
+		rx_napi = &net_priv->rx_napi.q[i];
+		len += scnprintf(buf + len, sizeof(buf) - len, "%u %-3d %u %u %u\n", i, rx_napi->cpu,
+				 rx_napi->poll_cnt, rx_napi->frame_cnt, rx_napi->ipi_cnt);
+	}
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(rx_queue);
+#endif
+
+#ifdef CONFIG_RS_XDP
+static ssize_t rs_dbgfs_xdp_read(struct file *file, char __user *user_buf, size_t count, loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_net_vif_priv *vif_priv = NULL;
+	char buf[512];
+	size_t len = 0;
+	u8 i = 0;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "vif prog aborted drop pass tx redirect xmit err\n");
+	for (i = 0; i < RS_NET_PRIV_VIF_TABLE_MAX; i++) {
+		vif_priv = net_priv->vif_table[i];
+		if (vif_priv) {
+			len += scnprintf(buf + len, sizeof(buf) - len, "%-3u %-4u %u %u %u %u %u %u %u\n", i,
+					 rcu_access_pointer(vif_priv->xdp.prog) ? 1 : 0,
+					 vif_priv->xdp.act_cnt[XDP_ABORTED], vif_priv->xdp.act_cnt[XDP_DROP],
+					 vif_priv->xdp.act_cnt[XDP_PASS], vif_priv->xdp.act_cnt[XDP_TX],
+					 vif_priv->xdp.act_cnt[XDP_REDIRECT], vif_priv->xdp.xmit_cnt,
+					 vif_priv->xdp.xmit_err_cnt);
+		}
+	}
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RD(xdp);
+#endif
+
+#ifdef CONFIG_RS_Q_BENCH
+static bool rs_dbgfs_q_bench_push(struct rs_dbgfs_q_bench *bench, void *data)
+{
+	bool pushed = FALSE;
+	s32 idx = RS_FAIL;
+
+	if (bench->use_ring) {
+		idx = rs_c_ring_prod_idx(&bench->ring);
+		if (idx >= 0) {
+			bench->buf[idx] = data;
+			rs_c_ring_prod_commit(&bench->ring);
+			pushed = TRUE;
+		}
+	} else {
+		(void)rs_k_spin_lock(&bench->lock);
+		idx = rs_c_q_push(&bench->q);
+		if (idx >= 0) {
+			bench->buf[idx] = data;
+			pushed = TRUE;
+		}
+		(void)rs_k_spin_unlock(&bench->lock);
+	}
+
+	return pushed;
+}
+
+static bool rs_dbgfs_q_bench_pop(struct rs_dbgfs_q_bench *bench)
+{
+	bool popped = FALSE;
+	s32 idx = RS_FAIL;
+
+	if (bench->use_ring) {
+		idx = rs_c_ring_cons_idx(&bench->ring);
+		if (idx >= 0) {
+			bench->buf[idx] = NULL;
+			rs_c_ring_cons_commit(&bench->ring);
+			popped = TRUE;
+		}
+	} else {
+		(void)rs_k_spin_lock(&bench->lock);
+		idx = rs_c_q_pop(&bench->q);
+		if (idx >= 0) {
+			bench->buf[idx] = NULL;
+			popped = TRUE;
+		}
+		(void)rs_k_spin_unlock(&bench->lock);
+	}
+
+	return popped;
+}
+
+static int rs_dbgfs_q_bench_producer(void *param)
+{
+	struct rs_dbgfs_q_bench *bench = param;
+	u32 i = 0;
+
+	while (i < bench->count) {
+		if (rs_dbgfs_q_bench_push(bench, bench)) {
+			i++;
+		} else {
+			cond_resched();
+		}
+	}
+
+	complete(&bench->done);
+
+	return 0;
+}
+
+static u64 rs_dbgfs_q_bench_run(struct rs_dbgfs_q_bench *bench, bool use_ring)
+{
+	struct task_struct *task = NULL;
+	u64 start_ns = 0;
+	u64 elapsed_ns = 0;
+	u32 i = 0;
+
+	bench->use_ring = use_ring;
+	(void)rs_c_q_init(&bench->q, RS_DBGFS_Q_BENCH_DEPTH);
+	(void)rs_c_ring_init(&bench->ring, RS_DBGFS_Q_BENCH_DEPTH);
+	init_completion(&bench->done);
+
+	start_ns = ktime_get_ns();
+
+	task = kthread_run(rs_dbgfs_q_bench_producer, bench, "RSW_Q_BENCH");
+	if (!IS_ERR(task)) {
+		while (i < bench->count) {
+			if (rs_dbgfs_q_bench_pop(bench)) {
+				i++;
+			} else {
+				cond_resched();
+			}
+		}
+
+		wait_for_completion(&bench->done);
+		elapsed_ns = ktime_get_ns() - start_ns;
+	}
+
+	return elapsed_ns;
+}
+
+static ssize_t rs_dbgfs_q_bench_write(struct file *file, const char __user *user_buf, size_t count,
+				      loff_t *ppos)
+{
+	struct rs_dbgfs_q_bench *bench = NULL;
+	u32 bench_cnt = RS_DBGFS_Q_BENCH_DEF_CNT;
+	ssize_t ret = count;
+
+	if (kstrtou32_from_user(user_buf, count, 0, &bench_cnt) || bench_cnt == 0) {
+		bench_cnt = RS_DBGFS_Q_BENCH_DEF_CNT;
+	}
+
+	bench = rs_k_calloc(sizeof(struct rs_dbgfs_q_bench));
+	if (!bench)
+		return -ENOMEM;
+
+	bench->count = bench_cnt;
+	(void)rs_k_spin_lock_create(&bench->lock);
+
+	q_bench_result.count = bench_cnt;
+	q_bench_result.q_ns = rs_dbgfs_q_bench_run(bench, FALSE);
+	q_bench_result.ring_ns = rs_dbgfs_q_bench_run(bench, TRUE);
+
+	(void)rs_k_spin_lock_destroy(&bench->lock);
+	rs_k_free(bench);
+
+	return ret;
+}
+
+static ssize_t rs_dbgfs_q_bench_read(struct file *file, char __user *user_buf, size_t count,
+				     loff_t *ppos)
+{
+	char buf[160];
+	size_t len = 0;
+
+	len += scnprintf(buf + len, sizeof(buf) - len, "count %u\n", q_bench_result.count);
+	len += scnprintf(buf + len, sizeof(buf) - len, "rs_c_q+spin_lock %llu ns (%llu ns/op)\n",
+			 q_bench_result.q_ns,
+			 q_bench_result.count ? div_u64(q_bench_result.q_ns, q_bench_result.count) : 0);
+	len += scnprintf(buf + len, sizeof(buf) - len, "rs_c_ring        %llu ns (%llu ns/op)\n",
+			 q_bench_result.ring_ns,
+			 q_bench_result.count ? div_u64(q_bench_result.ring_ns, q_bench_result.count) : 0);
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RW(q_bench);
+#endif
+
+#ifdef CONFIG_RS_SELFTEST
+static ssize_t rs_dbgfs_selftest_write(struct file *file, const char __user *user_buf, size_t count,
+				       loff_t *ppos)
+{
+	struct rs_net_cfg80211_priv *net_priv = file->private_data;
+	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	u32 i = 0;
+
+	if (!c_if || !c_if->core)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(selftest_table); i++) {
+		selftest_result[i] = selftest_table[i].run(c_if);
+	}
+	selftest_done = TRUE;
+
+	return count;
+}
+
+static ssize_t rs_dbgfs_selftest_read(struct file *file, char __user *user_buf, size_t count,
+				      loff_t *ppos)
+{
+	char buf[512];
+	size_t len = 0;
+	const char *result = NULL;
+	u32 i = 0;
+
+	for (i = 0; i < ARRAY_SIZE(selftest_table); i++) {
+		result = (selftest_result[i] == RS_SUCCESS) ? "pass" : "FAIL";
+		if (selftest_done == FALSE) {
+			result = "-";
+		}
+		len += scnprintf(buf + len, sizeof(buf) - len, "%-16s %s\n", selftest_table[i].name, result);
+	}
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+RS_DBGFS_OPS_RW(selftest);
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
@@ -172,7 +699,26 @@ rs_ret rs_net_dbgfs_register(struct rs_net_cfg80211_priv *net_priv)
 		return RS_MEMORY_FAIL;
 
 	RS_DBGFS_CR_FILE(stats, root_dir, 0600);
+	RS_DBGFS_CR_FILE(tx_ac, root_dir, 0600);
+	RS_DBGFS_CR_FILE(tx_aqm, root_dir, 0600);
+	RS_DBGFS_CR_FILE(tx_amsdu, root_dir, 0600);
+	RS_DBGFS_CR_FILE(rx_pool, root_dir, 0600);
+	RS_DBGFS_CR_FILE(rx_agg, root_dir, 0600);
+	RS_DBGFS_CR_FILE(rx_reorder, root_dir, 0600);
+	RS_DBGFS_CR_FILE(bus_hs, root_dir, 0600);
+#ifdef CONFIG_RS_NAPI
+	RS_DBGFS_CR_FILE(rx_queue, root_dir, 0600);
+#endif
+#ifdef CONFIG_RS_XDP
+	RS_DBGFS_CR_FILE(xdp, root_dir, 0600);
+#endif
 	RS_DBGFS_CR_U32(log_level, root_dir, &rs_log_level, 0600);
+#ifdef CONFIG_RS_Q_BENCH
+	RS_DBGFS_CR_FILE(q_bench, root_dir, 0600);
+#endif
+#ifdef CONFIG_RS_SELFTEST
+	RS_DBGFS_CR_FILE(selftest, root_dir, 0600);
+#endif
 
 	return ret;
 }
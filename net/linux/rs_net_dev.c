@@ -23,9 +23,11 @@
 #include "rs_net_ctrl.h"
 #include "rs_net_tx_data.h"
 #include "rs_net_skb.h"
+#include "rs_net_stats.h"
 
 #include "rs_net_dev.h"
 #include "rs_net_dfs.h"
+#include "rs_net_xdp.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
@@ -33,30 +35,50 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
+static int ndo_init(struct net_device *ndev);
 static int ndo_open(struct net_device *ndev);
 static int ndo_close(struct net_device *ndev);
 static netdev_tx_t ndo_start_xmit(struct sk_buff *skb, struct net_device *ndev);
 static u16 ndo_select_queue(struct net_device *dev, struct sk_buff *skb, struct net_device *sb_dev);
 static int ndo_set_mac_address(struct net_device *ndev, void *addr);
+static void ndo_get_stats64(struct net_device *ndev, struct rtnl_link_stats64 *stats);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
 
-static const struct net_device_ops rs_net_dev_ops = { .ndo_open = ndo_open,
+static const struct net_device_ops rs_net_dev_ops = { .ndo_init = ndo_init,
+						      .ndo_open = ndo_open,
 						      .ndo_stop = ndo_close,
 						      .ndo_start_xmit = ndo_start_xmit,
 						      .ndo_select_queue = ndo_select_queue,
+#ifdef CONFIG_RS_XDP
+						      .ndo_bpf = rs_net_xdp_bpf,
+						      .ndo_xdp_xmit = rs_net_xdp_xmit,
+#endif
+						      .ndo_get_stats64 = ndo_get_stats64,
 						      .ndo_set_mac_address = ndo_set_mac_address };
 
 static const struct net_device_ops rs_net_dev_monitor_ops = {
+	.ndo_init = ndo_init,
 	.ndo_open = ndo_open,
 	.ndo_stop = ndo_close,
+	.ndo_get_stats64 = ndo_get_stats64,
 	.ndo_set_mac_address = ndo_set_mac_address,
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+// Counters are freed by net_dev_priv_destructor when netdev is freed
+static int ndo_init(struct net_device *ndev)
+{
+	struct rs_net_vif_priv *vif_priv = netdev_priv(ndev);
+
+	vif_priv->pcpu_stats = rs_net_stats_pcpu_alloc();
+
+	return vif_priv->pcpu_stats ? 0 : -ENOMEM;
+}
+
 static int ndo_open(struct net_device *ndev)
 {
 	rs_ret ret = RS_FAIL;
@@ -64,6 +86,7 @@ static int ndo_open(struct net_device *ndev)
 	struct rs_net_cfg80211_priv *net_priv = rs_vif_priv_get_net_priv(vif_priv);
 	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
 	struct rs_c_add_if_rsp *add_if_rsp = &net_priv->cmd_rsp.add_if;
+	u32 i = 0;
 
 	RS_TRACE(RS_FN_ENTRY_STR);
 
@@ -101,6 +124,17 @@ static int ndo_open(struct net_device *ndev)
 	}
 
 	if (ret == RS_SUCCESS) {
+		// restart BQL, frames still queued from a previous open are not completed
+		vif_priv->bql_epoch++;
+		for (i = 0; i < ndev->num_tx_queues; i++) {
+			netdev_tx_reset_queue(netdev_get_tx_queue(ndev, i));
+		}
+
+#ifdef CONFIG_RS_XDP
+		// XDP program is skipped without it, vif works anyway
+		(void)rs_net_xdp_open(net_priv, vif_priv);
+#endif
+
 		vif_priv->up = TRUE;
 		net_priv->vif_started++;
 		ret = rs_net_priv_set_vif_priv(net_priv, vif_priv->vif_index, vif_priv);
@@ -160,6 +194,10 @@ static int ndo_close(struct net_device *ndev)
 		ret = rs_net_priv_set_vif_priv(net_priv, vif_priv->vif_index, NULL);
 		vif_priv->vif_index = RS_NET_INVALID_VIF_IDX;
 
+#ifdef CONFIG_RS_XDP
+		rs_net_xdp_close(vif_priv);
+#endif
+
 		(void)rs_net_cfg80211_unset_chaninfo(vif_priv);
 
 		if (RS_NET_WDEV_IF_TYPE(vif_priv) == NL80211_IFTYPE_MONITOR)
@@ -187,20 +225,23 @@ static netdev_tx_t ndo_start_xmit(struct sk_buff *skb, struct net_device *ndev)
 	struct rs_net_vif_priv *vif_priv = netdev_priv(ndev);
 	struct rs_net_cfg80211_priv *net_priv = rs_vif_priv_get_net_priv(vif_priv);
 	struct rs_c_if *c_if = rs_net_priv_get_c_if(net_priv);
+	struct rs_net_sta_priv *sta = NULL;
 	u32 tx_len = skb->len;
+	bool sent = FALSE;
+
+	// netdev queue of frame is its station, skb may be gone after TX
+	sta = rs_net_priv_get_sta_info(net_priv, skb_get_queue_mapping(skb));
 
 	ret = rs_net_tx_data(c_if, vif_priv, (u8 *)skb);
 	if (tx_len == 0) {
-		RS_DBG("P:%s[%d]:tx_packets[%d]:tx_bytes[%d][%d]:tx_dropped[%d]\n", __func__, __LINE__,
-		       ndev->stats.tx_packets, tx_len, ndev->stats.tx_bytes, ndev->stats.tx_dropped);
+		RS_DBG("P:%s[%d]:tx_len[%d]\n", __func__, __LINE__, tx_len);
 	}
 
-	if (ret == RS_SUCCESS) {
-		ndev->stats.tx_packets++;
-		ndev->stats.tx_bytes += tx_len;
-	} else {
-		// netdev_ret = NETDEV_TX_BUSY;
-		ndev->stats.tx_dropped++;
+	// frame TX path did not take is dropped rather than requeued with NETDEV_TX_BUSY
+	sent = (ret == RS_SUCCESS) ? TRUE : FALSE;
+	rs_net_stats_tx(vif_priv->pcpu_stats, tx_len, sent);
+	if (sta) {
+		rs_net_stats_tx(sta->stats.pcpu, tx_len, sent);
 	}
 
 	return netdev_ret;
@@ -302,6 +343,24 @@ static int ndo_set_mac_address(struct net_device *ndev, void *addr)
 	return ret;
 }
 
+// Sum of per CPU counters, dev_get_stats zeroes stats before
+static void ndo_get_stats64(struct net_device *ndev, struct rtnl_link_stats64 *stats)
+{
+	struct rs_net_vif_priv *vif_priv = netdev_priv(ndev);
+
+	rs_net_stats_pcpu_sum(vif_priv->pcpu_stats, stats);
+}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 12, 0)
+static void net_dev_priv_destructor(struct net_device *ndev)
+{
+	struct rs_net_vif_priv *vif_priv = netdev_priv(ndev);
+
+	rs_net_stats_pcpu_free(vif_priv->pcpu_stats);
+	vif_priv->pcpu_stats = NULL;
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
@@ -309,8 +368,6 @@ void rs_net_dev_init(rs_net_dev_t *ndev)
 {
 	struct net_device *temp_ndev = ndev;
 
-	u16 hdr_size = RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, 0) + 32;
-
 	if (temp_ndev) {
 		ether_setup(temp_ndev);
 
@@ -322,10 +379,12 @@ void rs_net_dev_init(rs_net_dev_t *ndev)
 		dev->destructor = free_netdev;
 #else
 		temp_ndev->needs_free_netdev = true;
+		temp_ndev->priv_destructor = net_dev_priv_destructor;
 #endif
 		temp_ndev->watchdog_timeo = RS_C_TX_LIFETIME_MS;
-		temp_ndev->needed_headroom = hdr_size;
-		temp_ndev->hw_features = 0;
+		// IF TX header goes to bus as own fragment, paged frames are taken as they are
+		temp_ndev->hw_features = NETIF_F_SG;
+		temp_ndev->features |= NETIF_F_SG;
 	}
 }
 
@@ -336,6 +395,11 @@ rs_ret rs_net_dev_set_ops(rs_net_dev_t *ndev)
 
 	if (temp_ndev) {
 		temp_ndev->netdev_ops = &rs_net_dev_ops;
+#if defined(CONFIG_RS_XDP) && (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0))
+		// redirect to this netdev is refused without NDO_XMIT
+		xdp_set_features_flag(temp_ndev, NETDEV_XDP_ACT_BASIC | NETDEV_XDP_ACT_REDIRECT |
+							 NETDEV_XDP_ACT_NDO_XMIT);
+#endif
 
 		ret = RS_SUCCESS;
 	}
@@ -350,6 +414,9 @@ rs_ret rs_net_dev_set_monitor_ops(rs_net_dev_t *ndev)
 
 	if (temp_ndev) {
 		temp_ndev->netdev_ops = &rs_net_dev_monitor_ops;
+#if defined(CONFIG_RS_XDP) && (LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0))
+		xdp_clear_features_flag(temp_ndev);
+#endif
 
 		ret = RS_SUCCESS;
 	}
@@ -381,6 +448,25 @@ rs_ret rs_net_dev_rx(rs_net_dev_t *ndev, u8 *skb)
 	return ret;
 }
 
+rs_ret rs_net_dev_rx_gro(rs_net_dev_t *ndev, void *napi, u8 *skb)
+{
+	rs_ret ret = RS_FAIL;
+	struct net_device *temp_ndev = ndev;
+	struct sk_buff *temp_skb = (struct sk_buff *)skb;
+
+	if ((temp_ndev) && (napi) && (temp_skb)) {
+		if (rs_net_if_is_up(ndev) == RS_SUCCESS) {
+			(void)napi_gro_receive((struct napi_struct *)napi, temp_skb);
+			ret = RS_SUCCESS;
+		} else {
+			rs_net_skb_free(skb);
+			temp_skb = NULL;
+		}
+	}
+
+	return ret;
+}
+
 rs_ret rs_net_if_is_up(rs_net_dev_t *ndev)
 {
 	rs_ret ret = RS_FAIL;
@@ -83,12 +83,20 @@ struct module_param_list {
 	bool use_sgi;
 
 	u32 log_level;
+
+	// RX data queues with own NAPI, CPU each is polled on
+	s32 rx_queues;
+	s32 rx_cpus[RS_C_RX_DATA_Q_MAX];
+	u32 rx_cpus_num;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL VARIABLE
 
-struct module_param_list net_module_param_list = { .he_enable = true, .he_ul_on = true };
+struct module_param_list net_module_param_list = { .he_enable = true,
+						   .he_ul_on = true,
+						   .rx_queues = 1,
+						   .rx_cpus = { [0 ... RS_C_RX_DATA_Q_MAX - 1] = -1 } };
 
 /* Regulatory rules */
 static struct ieee80211_regdomain net_param_regdom = { .n_reg_rules = 2,
@@ -150,6 +158,13 @@ MODULE_PARM_DESC(log_level, "log_level (Default: 7: error + warning + info)");
 module_param_named(he_enable, net_module_param_list.he_enable, bool, 0444);
 MODULE_PARM_DESC(he_enable, "Enable HE (Default: 1-Enabled)");
 
+module_param_named(rx_queues, net_module_param_list.rx_queues, int, 0444);
+MODULE_PARM_DESC(rx_queues, "RX data queues with own NAPI, hashed by vif, station and TID (Default: 1)");
+
+module_param_array_named(rx_cpus, net_module_param_list.rx_cpus, int, &net_module_param_list.rx_cpus_num,
+			 0444);
+MODULE_PARM_DESC(rx_cpus, "CPU of each RX data queue, -1 for CPU of RX thread (Default: -1)");
+
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
@@ -954,4 +969,42 @@ u32 rs_net_params_get_uapsd_threshold(struct rs_c_if *c_if)
 	}
 
 	return uapsd_threshold;
-}
\ No newline at end of file
+}
+
+u8 rs_net_params_get_rx_queues(struct rs_c_if *c_if)
+{
+	s32 rx_queues = 1;
+
+	(void)c_if;
+
+#ifdef CONFIG_RS_NAPI
+	rx_queues = net_module_param_list.rx_queues;
+	if (rx_queues < 1) {
+		rx_queues = 1;
+	} else if (rx_queues > RS_C_RX_DATA_Q_MAX) {
+		RS_WARN("rx_queues %d above %d\n", rx_queues, RS_C_RX_DATA_Q_MAX);
+		rx_queues = RS_C_RX_DATA_Q_MAX;
+	}
+#endif
+
+	return (u8)rx_queues;
+}
+
+s32 rs_net_params_get_rx_cpu(struct rs_c_if *c_if, u8 q_idx)
+{
+	s32 cpu = -1;
+
+	(void)c_if;
+
+	if (q_idx < net_module_param_list.rx_cpus_num) {
+		cpu = net_module_param_list.rx_cpus[q_idx];
+		if ((cpu >= (s32)nr_cpu_ids) || ((cpu >= 0) && !cpu_online(cpu))) {
+			RS_WARN("rx_cpus[%u] %d not online\n", q_idx, cpu);
+			cpu = -1;
+		} else if (cpu < 0) {
+			cpu = -1;
+		}
+	}
+
+	return cpu;
+}
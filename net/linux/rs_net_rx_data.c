@@ -17,13 +17,17 @@
 #include "rs_c_if.h"
 #include "rs_core.h"
 #include "rs_c_status.h"
+#include "rs_c_rx.h"
 
 #include "rs_net_cfg80211.h"
 #include "rs_net_priv.h"
 #include "rs_net_dev.h"
 #include "rs_net_skb.h"
+#include "rs_net_params.h"
 
 #include "rs_net_rx_data.h"
+#include "rs_net_rx_reorder.h"
+#include "rs_net_xdp.h"
 #include "rs_net_stats.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,39 +42,46 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+// ext_hdr is a copy for data frames, their buffer belongs to network stack once delivered
+// Counters are per CPU, caller has BH disabled, rate info of station is sampled once per jiffy
 static rs_ret net_rx_update_stats(struct rs_net_cfg80211_priv *net_priv, struct rs_net_vif_priv *vif_priv,
-				  u8 sta_idx, u8 pkt_t, struct rs_c_rx_data *rx_data, rs_ret ret_succ)
+				  u8 sta_idx, u8 pkt_t, struct rs_c_rx_ext_hdr *ext_hdr, u16 data_len,
+				  rs_ret ret_succ)
 {
 	rs_ret ret = RS_FAIL;
 	struct net_device *ndev = NULL;
 	struct rs_net_sta_priv *sta = NULL;
+	u32 now = (u32)jiffies;
 
 	ndev = rs_vif_priv_get_ndev(vif_priv);
-	if ((net_priv) && (ndev) && (rx_data)) {
+	if ((net_priv) && (ndev) && (ext_hdr)) {
 		sta = rs_net_priv_get_sta_info(net_priv, sta_idx);
-		if (sta) {
-			sta->stats.last_acttive_time = jiffies;
-			sta->stats.last_rx_data_ext = rx_data->ext_hdr;
+		if (sta && (sta->stats.last_acttive_time != now)) {
+			sta->stats.last_acttive_time = now;
+			sta->stats.last_rx_data_ext = *ext_hdr;
 
-			if (sta->stats.last_rx_data_ext.format_mod > 1) {
-				sta->stats.last_stats = rx_data->ext_hdr;
+			if (ext_hdr->format_mod > 1) {
+				sta->stats.last_stats = *ext_hdr;
 			}
+
+#ifdef CONFIG_DBG_STATS
+			rs_net_rx_status_update(net_priv, ext_hdr);
+#endif
 		}
 
 		if (ret_succ == RS_SUCCESS) {
-			ndev->stats.rx_bytes += rx_data->data_len;
-			ndev->stats.rx_packets++;
-			if (pkt_t == PACKET_MULTICAST) {
-				ndev->stats.multicast++;
+			rs_net_stats_rx(vif_priv->pcpu_stats, data_len,
+					(pkt_t == PACKET_MULTICAST) ? TRUE : FALSE);
+			if (sta) {
+				rs_net_stats_rx(sta->stats.pcpu, data_len, FALSE);
 			}
 		} else {
-			ndev->stats.rx_dropped++;
+			rs_net_stats_rx_drop(vif_priv->pcpu_stats);
+			if (sta) {
+				rs_net_stats_rx_drop(sta->stats.pcpu);
+			}
 		}
 
-#ifdef CONFIG_DBG_STATS
-		rs_net_rx_status_update(net_priv, &sta->stats);
-#endif
-
 		ret = RS_SUCCESS;
 	}
 
@@ -213,47 +224,166 @@ static rs_ret net_rx_mgmt(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_
 		ret = net_rx_mgmt_set(net_priv, rx_data, vif_index);
 	}
 
-	(void)net_rx_update_stats(net_priv, vif_priv, sta_index, PACKET_HOST, rx_data, ret);
+	// RX thread may deliver management frames, counters are updated with BH disabled
+	local_bh_disable();
+	(void)net_rx_update_stats(net_priv, vif_priv, sta_index, PACKET_HOST, &rx_data->ext_hdr,
+				  rx_data->data_len, ret);
+	local_bh_enable();
 
 	return ret;
 }
 
-static rs_ret net_rx_sta(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_data *rx_data)
+// Split A-MSDU into Ethernet frames, subframes share RX buffer as page fragments
+// Last subframe keeps skb, list is empty when A-MSDU is malformed and skb is freed
+static void net_rx_amsdu(struct rs_net_vif_priv *vif_priv, struct sk_buff *skb, struct sk_buff_head *list)
+{
+	struct net_device *ndev = rs_vif_priv_get_ndev(vif_priv);
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0)
+	ieee80211_amsdu_to_8023s(skb, list, ndev->dev_addr, RS_NET_WDEV_IF_TYPE(vif_priv), 0, NULL, NULL,
+				 0);
+#else
+	ieee80211_amsdu_to_8023s(skb, list, ndev->dev_addr, RS_NET_WDEV_IF_TYPE(vif_priv), 0, NULL, NULL);
+#endif
+}
+
+// Deliver Ethernet frames of one MPDU, through GRO when called from NAPI poll
+static rs_ret net_rx_deliver(struct rs_net_cfg80211_priv *net_priv, struct rs_net_vif_priv *vif_priv,
+			     struct rs_c_rx_ext_hdr *ext_hdr, struct sk_buff_head *list, bool gro)
+{
+	rs_ret ret = RS_FAIL;
+	struct net_device *ndev = rs_vif_priv_get_ndev(vif_priv);
+	struct sk_buff *skb = NULL;
+	rs_ret ret_skb = RS_FAIL;
+	u16 data_len = 0;
+	s16 pkt_type = 0;
+
+	while ((skb = __skb_dequeue(list)) != NULL) {
+		data_len = skb->len;
+
+		skb->dev = ndev;
+		skb->priority = ext_hdr->priority;
+		skb->protocol = eth_type_trans(skb, skb->dev);
+		pkt_type = skb->pkt_type;
+
+#ifdef CONFIG_RS_NAPI
+		if (gro == TRUE) {
+			// NAPI of MPDU queue is the one in poll on this CPU
+			ret_skb = rs_net_dev_rx_gro(ndev, &rs_net_rx_napi_get(net_priv, ext_hdr)->napi,
+						    (u8 *)skb);
+		} else {
+			ret_skb = rs_net_dev_rx(ndev, (u8 *)skb);
+		}
+#else
+		ret_skb = rs_net_dev_rx(ndev, (u8 *)skb);
+#endif
+		if (ret_skb == RS_SUCCESS) {
+			ret = RS_SUCCESS;
+		}
+
+		(void)net_rx_update_stats(net_priv, vif_priv, ext_hdr->sta_idx, pkt_type, ext_hdr, data_len,
+					  ret_skb);
+	}
+
+	return ret;
+}
+
+// Split MPDU into Ethernet frames and deliver them
+static rs_ret net_rx_mpdu(struct rs_net_cfg80211_priv *net_priv, struct sk_buff *skb, bool gro)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_net_vif_priv *vif_priv = NULL;
+	struct net_device *ndev = NULL;
+	struct sk_buff_head list;
+	struct rs_c_rx_ext_hdr ext_hdr;
+
+	// control buffer is not kept by A-MSDU split
+	ext_hdr = RS_NET_RX_CB(skb)->ext_hdr;
+
+	vif_priv = rs_net_priv_get_vif_priv(net_priv, ext_hdr.vif_idx);
+	ndev = rs_vif_priv_get_ndev(vif_priv);
+
+	if (vif_priv && ndev) {
+		skb->dev = ndev;
+		skb->priority = ext_hdr.priority;
+		__skb_queue_head_init(&list);
+
+		if (ext_hdr.amsdu == 1) {
+			net_rx_amsdu(vif_priv, skb, &list);
+
+			RS_C_DBG_STAT_INC(rx.nb_amsdu);
+			RS_C_DBG_STAT_ADD(rx.nb_amsdu_sub, skb_queue_len(&list));
+			if (skb_queue_empty(&list)) {
+				rs_net_stats_rx_drop(vif_priv->pcpu_stats);
+			}
+		} else {
+			__skb_queue_tail(&list, skb);
+		}
+
+		ret = net_rx_deliver(net_priv, vif_priv, &ext_hdr, &list, gro);
+	} else {
+		// vif went down while MPDU was held for reorder
+		rs_net_skb_free((u8 *)skb);
+	}
+
+	return ret;
+}
+
+// Data frame is not copied, sk_buff is built on its RX buffer and IF headers are pulled
+static rs_ret net_rx_sta(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_data *rx_data, bool *taken)
 {
 	rs_ret ret = RS_FAIL;
 	struct rs_net_vif_priv *vif_priv = NULL;
 	struct net_device *ndev = NULL;
 	struct sk_buff *skb = NULL;
-	u8 *skb_data_buff = NULL;
+	struct sk_buff_head list;
+	struct rs_c_rx_ext_hdr ext_hdr;
+	rs_ret xdp_ret = RS_SUCCESS;
+	u16 data_len = 0;
 	s16 sta_index = -1;
 	s16 vif_index = -1;
-	s16 priority = 0;
-	s16 pkt_type = 0;
 
 	sta_index = rx_data->ext_hdr.sta_idx;
 	vif_index = rx_data->ext_hdr.vif_idx;
-	priority = rx_data->ext_hdr.priority;
 
 	vif_priv = rs_net_priv_get_vif_priv(net_priv, vif_index);
 	ndev = rs_vif_priv_get_ndev(vif_priv);
 
-	if (vif_priv) {
-		skb = (struct sk_buff *)rs_net_skb_alloc(rx_data->data_len);
+	if (vif_priv && ndev) {
+		// header is gone with skb after delivery
+		ext_hdr = rx_data->ext_hdr;
+		data_len = rx_data->data_len;
+
+		__skb_queue_head_init(&list);
+
+#ifdef CONFIG_RS_XDP
+		// program may end frame on RX buffer, or pass it on sk_buff built for its new bounds
+		xdp_ret = rs_net_xdp_rx(net_priv, vif_priv, rx_data, (u8 **)&skb, taken);
+#endif
+
+		if ((xdp_ret == RS_SUCCESS) && !skb) {
+			skb = (struct sk_buff *)rs_net_skb_rx_build((u8 *)rx_data, RS_C_RX_BUF_SIZE,
+								     rx_data->data - (u8 *)rx_data, data_len);
+			if (skb) {
+				*taken = TRUE;
+			}
+		}
+
 		if (skb) {
-			// set skb
-			skb->dev = ndev;
-			(void)rs_net_skb_get_data((u8 *)skb, &skb_data_buff);
-			if (skb->dev && skb_data_buff) {
-				(void)rs_k_memcpy(skb_data_buff, rx_data->data, rx_data->data_len);
-				skb->priority = priority;
-				skb->protocol = eth_type_trans(skb, skb->dev);
-				pkt_type = skb->pkt_type;
-
-				ret = rs_net_dev_rx(ndev, (u8 *)skb);
-
-				(void)net_rx_update_stats(net_priv, vif_priv, sta_index, pkt_type, rx_data,
-							  ret);
+			RS_NET_RX_CB(skb)->ext_hdr = ext_hdr;
+
+			// MPDUs held for missing ones stay in reorder buffer, in order ones come in list
+			if (ext_hdr.sn_valid == 1) {
+				rs_net_rx_reorder(net_priv, skb, &list);
+			} else {
+				__skb_queue_tail(&list, skb);
 			}
+
+			ret = rs_net_rx_data_deliver(net_priv, &list, TRUE);
+		} else if (ext_hdr.sn_valid == 1) {
+			// MPDU ended here still uses up its sequence number, held ones behind it go on
+			rs_net_rx_reorder_skip(net_priv, &ext_hdr, &list);
+			(void)rs_net_rx_data_deliver(net_priv, &list, TRUE);
 		}
 	} else {
 		RS_DBG("P:%s[%d]:sta[%d]:vif[%d]:data_len[%d]\n", __func__, __LINE__, sta_index, vif_index,
@@ -263,6 +393,60 @@ static rs_ret net_rx_sta(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_d
 	return ret;
 }
 
+#ifdef CONFIG_RS_NAPI
+static int net_rx_napi_poll(struct napi_struct *napi, int budget)
+{
+	struct rs_net_rx_napi *rx_napi = NULL;
+	u32 done = 0;
+
+	rx_napi = container_of(napi, struct rs_net_rx_napi, napi);
+	done = rs_c_rx_data_poll(rs_net_priv_get_c_if(rx_napi->net_priv), rx_napi->q_idx, budget);
+#ifdef CONFIG_RS_XDP
+	rs_net_xdp_flush(rx_napi);
+#endif
+	rx_napi->poll_cnt++;
+	rx_napi->frame_cnt += done;
+
+	if (done < budget) {
+		(void)napi_complete_done(napi, done);
+	}
+
+	return done;
+}
+
+// IPI on CPU poll is steered to, RX thread already marked NAPI scheduled
+static void net_rx_napi_ipi(void *param)
+{
+	struct rs_net_rx_napi *rx_napi = param;
+
+	__napi_schedule_irqoff(&rx_napi->napi);
+}
+
+static void net_rx_napi_add(struct rs_net_cfg80211_priv *net_priv, u8 q_idx, s32 cpu)
+{
+	struct rs_net_rx_napi *rx_napi = &net_priv->rx_napi.q[q_idx];
+
+	rx_napi->net_priv = net_priv;
+	rx_napi->q_idx = q_idx;
+	rx_napi->cpu = cpu;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
+	INIT_CSD(&rx_napi->csd, net_rx_napi_ipi, rx_napi);
+#else
+	rx_napi->csd.func = net_rx_napi_ipi;
+	rx_napi->csd.info = rx_napi;
+#endif
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
+	netif_napi_add(net_priv->rx_napi.ndev, &rx_napi->napi, net_rx_napi_poll);
+#else
+	netif_napi_add(net_priv->rx_napi.ndev, &rx_napi->napi, net_rx_napi_poll, NAPI_POLL_WEIGHT);
+#endif
+	napi_enable(&rx_napi->napi);
+
+	RS_INFO("RX queue %u polled on CPU %d\n", q_idx, cpu);
+}
+#endif
+
 // static rs_ret net_rx_mon(struct rs_c_if *c_if, struct rs_c_data *rx_data)
 // {
 //	rs_ret ret = RS_FAIL;
@@ -274,7 +458,7 @@ static rs_ret net_rx_sta(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_d
 /// GLOBAL FUNCTION
 
 // RX Data handler
-rs_ret rs_net_rx_data(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data)
+rs_ret rs_net_rx_data(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data, bool *taken)
 {
 	rs_ret ret = RS_FAIL;
 	struct rs_net_cfg80211_priv *net_priv = NULL;
@@ -283,20 +467,156 @@ rs_ret rs_net_rx_data(struct rs_c_if *c_if, struct rs_c_rx_data *rx_data)
 
 	net_priv = rs_c_if_get_net_priv(c_if);
 
-	if (net_priv && rx_data) {
-		if (rx_data->ext_len == RS_C_RX_EXT_LEN && rx_data->data_len > 0) {
+	if (taken) {
+		*taken = FALSE;
+	}
+
+	if (net_priv && rx_data && taken) {
+		if (rx_data->ext_len == RS_C_RX_EXT_LEN && rx_data->data_len > 0 &&
+		    rx_data->data_len <= RS_C_DATA_SIZE) {
 			if (rx_data->ext_hdr.mpdu == 1) {
 				ret = net_rx_mgmt(net_priv, rx_data);
 			} else {
-				ret = net_rx_sta(net_priv, rx_data);
+				ret = net_rx_sta(net_priv, rx_data, taken);
 			}
-			rs_c_dbg_stat.rx.nb_recv++;
+			RS_C_DBG_STAT_INC(rx.nb_recv);
 		} else {
 			RS_DBG("P:%s[%d]:[%d]:elen[%d]:dlen[%d]\n", __func__, __LINE__, ret, rx_data->ext_len,
 			       rx_data->data_len);
-			rs_c_dbg_stat.rx.nb_err_len++;
+			RS_C_DBG_STAT_INC(rx.nb_err_len);
+		}
+	}
+
+	return ret;
+}
+
+rs_ret rs_net_rx_data_deliver(struct rs_net_cfg80211_priv *net_priv, struct sk_buff_head *list, bool gro)
+{
+	rs_ret ret = RS_SUCCESS;
+	struct sk_buff *skb = NULL;
+
+	// without NAPI stack runs frames once all are queued
+	local_bh_disable();
+	while ((skb = __skb_dequeue(list)) != NULL) {
+		if (net_rx_mpdu(net_priv, skb, gro) != RS_SUCCESS) {
+			ret = RS_FAIL;
+		}
+	}
+	local_bh_enable();
+
+	return ret;
+}
+
+#ifdef CONFIG_RS_NAPI
+rs_ret rs_net_rx_napi_init(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_net_cfg80211_priv *net_priv = NULL;
+	struct net_device *ndev = NULL;
+	u8 q_num = 0;
+	u8 i = 0;
+
+	net_priv = rs_c_if_get_net_priv(c_if);
+	if (net_priv) {
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 9, 0)
+		ndev = alloc_netdev_dummy(0);
+#else
+		ndev = rs_k_calloc(sizeof(struct net_device));
+		if (ndev) {
+			init_dummy_netdev(ndev);
+		}
+#endif
+	}
+
+	if (ndev) {
+		net_priv->rx_napi.ndev = ndev;
+		q_num = rs_net_params_get_rx_queues(c_if);
+		for (i = 0; i < q_num; i++) {
+			net_rx_napi_add(net_priv, i, rs_net_params_get_rx_cpu(c_if, i));
+		}
+		net_priv->rx_napi.q_num = q_num;
+
+		// RX thread hashes frames over all queues from here
+		(void)rs_c_rx_data_set_q_num(c_if, q_num);
+		net_priv->rx_napi.enabled = TRUE;
+
+		// frames queued before NAPI was there
+		for (i = 0; i < q_num; i++) {
+			rs_net_rx_data_schedule(c_if, i);
+		}
+
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+rs_ret rs_net_rx_napi_deinit(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_net_cfg80211_priv *net_priv = NULL;
+	u8 i = 0;
+
+	net_priv = rs_c_if_get_net_priv(c_if);
+	if (net_priv && net_priv->rx_napi.ndev) {
+		// a steered schedule in flight is polled before napi_disable returns
+		for (i = 0; i < net_priv->rx_napi.q_num; i++) {
+			if (net_priv->rx_napi.enabled == TRUE) {
+				napi_disable(&net_priv->rx_napi.q[i].napi);
+			}
+			netif_napi_del(&net_priv->rx_napi.q[i].napi);
 		}
+		net_priv->rx_napi.enabled = FALSE;
+		net_priv->rx_napi.q_num = 0;
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 9, 0)
+		free_netdev(net_priv->rx_napi.ndev);
+#else
+		rs_k_free(net_priv->rx_napi.ndev);
+#endif
+		net_priv->rx_napi.ndev = NULL;
+
+		ret = RS_SUCCESS;
 	}
 
 	return ret;
 }
+
+void rs_net_rx_data_schedule(struct rs_c_if *c_if, u8 q_idx)
+{
+	struct rs_net_cfg80211_priv *net_priv = NULL;
+	struct rs_net_rx_napi *rx_napi = NULL;
+
+	net_priv = rs_c_if_get_net_priv(c_if);
+	if (net_priv && (net_priv->rx_napi.enabled == TRUE) && (q_idx < net_priv->rx_napi.q_num)) {
+		rx_napi = &net_priv->rx_napi.q[q_idx];
+		if (rx_napi->cpu < 0) {
+			// scheduled from RX thread, softirq runs at bh enable rather than in ksoftirqd
+			local_bh_disable();
+			napi_schedule(&rx_napi->napi);
+			local_bh_enable();
+		} else if (napi_schedule_prep(&rx_napi->napi)) {
+			// as RPS does, poll runs in softirq of steered CPU, IPI only when NAPI was idle
+			rx_napi->ipi_cnt++;
+			if (smp_call_function_single_async(rx_napi->cpu, &rx_napi->csd) != 0) {
+				// CPU went offline, frames are polled here
+				local_bh_disable();
+				__napi_schedule(&rx_napi->napi);
+				local_bh_enable();
+			}
+		}
+	}
+}
+
+struct rs_net_rx_napi *rs_net_rx_napi_get(struct rs_net_cfg80211_priv *net_priv,
+					  struct rs_c_rx_ext_hdr *ext_hdr)
+{
+	u8 q_idx = rs_c_rx_data_q_idx(rs_net_priv_get_c_if(net_priv), ext_hdr);
+
+	if (q_idx >= net_priv->rx_napi.q_num) {
+		q_idx = 0;
+	}
+
+	return &net_priv->rx_napi.q[q_idx];
+}
+#endif
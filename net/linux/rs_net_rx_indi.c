@@ -26,6 +26,7 @@
 #include "rs_net_dev.h"
 #include "rs_net_ctrl.h"
 #include "rs_net_tx_data.h"
+#include "rs_net_rx_reorder.h"
 
 #include "rs_net_rx_indi.h"
 #include "rs_net_dfs.h"
@@ -34,6 +35,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
+// longest firmware stay off channel without return indication, a passive scan dwell and margin
+#define NET_OFF_CHAN_WINDOW_US (150 * 1000)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -209,6 +213,13 @@ static int net_sm_connect_ind(struct rs_c_if *c_if, struct rs_c_indi *indi_data)
 		(void)rs_net_cfg80211_set_chaninfo(vif_priv, ind->ch_idx, &chandef);
 		rs_k_memcpy(sta->mac_addr, ind->bssid.addr, ETH_ALEN);
 		rs_k_memcpy(sta->ac_param, ind->edca_param, sizeof(sta->ac_param));
+		sta->ht = rs_net_params_get_ht_supported(c_if) &&
+			  (cfg80211_find_ie(WLAN_EID_HT_CAPABILITY, rsp_ie, ind->assoc_rsp_ie_len) != NULL);
+		// HT AP takes A-MSDUs of 3839 bytes at least, above host limit
+		(void)rs_c_tx_set_sta_amsdu(c_if, sta->sta_idx,
+					    (sta->qos && sta->ht) ? RS_C_TX_AMSDU_LEN : 0);
+		rs_net_rx_reorder_sta_reset(net_priv, sta->sta_idx);
+		rs_net_stats_pcpu_reset(sta->stats.pcpu);
 		extcap_ie = (u8 *)cfg80211_find_ie(WLAN_EID_EXT_CAPABILITY, rsp_ie, ind->assoc_rsp_ie_len);
 		if (extcap_ie && extcap_ie[1] >= 5) {
 			extcap = (void *)(extcap_ie);
@@ -291,6 +302,8 @@ static int net_sm_disconnect_ind(struct rs_c_if *c_if, struct rs_c_indi *indi_da
 	}
 
 	if (vif_priv->sta.ap) {
+		(void)rs_c_tx_set_sta_amsdu(c_if, vif_priv->sta.ap->sta_idx, 0);
+		rs_net_rx_reorder_sta_reset(net_priv, vif_priv->sta.ap->sta_idx);
 		vif_priv->sta.ap->valid = false;
 		vif_priv->sta.ap = NULL;
 	}
@@ -432,7 +445,8 @@ static inline int net_chan_pre_switch_ind(struct rs_c_if *c_if, struct rs_c_indi
 
 	net_priv = (struct rs_net_cfg80211_priv *)rs_c_if_get_net_priv(c_if);
 	if (net_priv && indi_data) {
-		// TODO: tx traffic stop
+		// leaving channel, hold TX until switch indication
+		(void)rs_c_tx_set_off_channel(c_if, NET_OFF_CHAN_WINDOW_US);
 	}
 
 	return 0;
@@ -477,9 +491,12 @@ static inline int net_chan_switch_ind(struct rs_c_if *c_if, struct rs_c_indi *in
 				return -1;
 			}
 
-			// TODO: tx traffic start on OFF channel
+			// data of operating channel is held for the remain on channel window
+			(void)rs_c_tx_set_off_channel(c_if, (ind->duration_us > 0) ? ind->duration_us :
+									       NET_OFF_CHAN_WINDOW_US);
 		} else {
-			// TODO: tx traffic start
+			// back on operating channel, drain frames held between off channel hops
+			(void)rs_c_tx_set_off_channel(c_if, 0);
 		}
 
 		net_priv->chaninfo_index = ind->chan_index;
@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include <linux/version.h>
+#include <linux/module.h>
+#include <linux/ieee80211.h>
+#include <net/cfg80211.h>
+
+#include "rs_type.h"
+#include "rs_k_mem.h"
+#include "rs_k_timer.h"
+#include "rs_c_dbg.h"
+#include "rs_c_if.h"
+#include "rs_core.h"
+#include "rs_c_cmd.h"
+
+#include "rs_net_cfg80211.h"
+#include "rs_net_priv.h"
+#include "rs_net_skb.h"
+#include "rs_net_rx_data.h"
+
+#include "rs_net_rx_reorder.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+// MPDU missing this long is given up, held ones behind it are released
+#define NET_RX_REORDER_TIMEOUT_US (100000)
+
+#define NET_RX_REORDER_SLOT(sn)	  ((sn) % RS_NET_RX_REORDER_WIN)
+
+#define NET_RX_REORDER_WIN_NUM	  (RS_NET_PRIV_STA_TABLE_MAX * RS_NET_RX_REORDER_TID_MAX)
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+// Release MPDU of head slot if held, head moves on over a missing one too
+// Slot of MPDU ended by XDP is marked without skb, it only lets window move on
+static void net_rx_reorder_release_head(struct rs_net_rx_reorder *win, struct sk_buff_head *list)
+{
+	u8 slot = NET_RX_REORDER_SLOT(win->head_sn);
+
+	if ((win->bitmap & BIT_ULL(slot)) != 0) {
+		if (win->buf[slot]) {
+			__skb_queue_tail(list, win->buf[slot]);
+			win->stored--;
+		}
+		win->buf[slot] = NULL;
+		win->bitmap &= ~BIT_ULL(slot);
+	}
+
+	win->head_sn = ieee80211_sn_inc(win->head_sn);
+}
+
+// Release held MPDUs from head up to first missing one
+static void net_rx_reorder_release_in_order(struct rs_net_rx_reorder *win, struct sk_buff_head *list)
+{
+	while ((win->bitmap & BIT_ULL(NET_RX_REORDER_SLOT(win->head_sn))) != 0) {
+		net_rx_reorder_release_head(win, list);
+	}
+}
+
+// Move head to sn, MPDUs before it are released and missing ones given up
+static void net_rx_reorder_release_until(struct rs_net_rx_reorder *win, u16 sn, struct sk_buff_head *list)
+{
+	while (ieee80211_sn_less(win->head_sn, sn)) {
+		net_rx_reorder_release_head(win, list);
+	}
+}
+
+// Free held MPDUs, next MPDU starts window again
+static void net_rx_reorder_reset(struct rs_net_rx_reorder *win)
+{
+	u8 slot = 0;
+
+	for (slot = 0; (slot < RS_NET_RX_REORDER_WIN) && (win->bitmap != 0); slot++) {
+		if (win->buf[slot]) {
+			rs_net_skb_free((u8 *)win->buf[slot]);
+			win->buf[slot] = NULL;
+		}
+		win->bitmap &= ~BIT_ULL(slot);
+	}
+
+	win->bitmap = 0;
+	win->stored = 0;
+	win->started = FALSE;
+}
+
+// Give up missing MPDUs in front of ones held longer than timeout
+// returns TRUE if MPDUs are still held
+static bool net_rx_reorder_expire(struct rs_net_rx_reorder *win, unsigned long now, struct sk_buff_head *list)
+{
+	unsigned long timeout = usecs_to_jiffies(NET_RX_REORDER_TIMEOUT_US);
+	struct sk_buff *skb = NULL;
+	bool expired = FALSE;
+	u16 last_sn = 0;
+	u16 sn = 0;
+	u8 i = 0;
+
+	for (i = 0; (i < RS_NET_RX_REORDER_WIN) && (win->stored > 0); i++) {
+		sn = ieee80211_sn_add(win->head_sn, i);
+		skb = win->buf[NET_RX_REORDER_SLOT(sn)];
+		if (skb && time_after_eq(now, RS_NET_RX_CB(skb)->rx_jiffies + timeout)) {
+			last_sn = sn;
+			expired = TRUE;
+		}
+	}
+
+	if (expired == TRUE) {
+		net_rx_reorder_release_until(win, ieee80211_sn_inc(last_sn), list);
+		net_rx_reorder_release_in_order(win, list);
+		win->stats.timeout_cnt++;
+	}
+
+	return (win->stored > 0) ? TRUE : FALSE;
+}
+
+static void net_rx_reorder_timer_handler(void *param)
+{
+	struct rs_net_cfg80211_priv *net_priv = (struct rs_net_cfg80211_priv *)param;
+	struct rs_net_rx_reorder *win_table = NULL;
+	struct rs_net_rx_reorder *win = NULL;
+	struct sk_buff_head list;
+	unsigned long now = jiffies;
+	bool held = FALSE;
+	u16 i = 0;
+
+	__skb_queue_head_init(&list);
+
+	// windows are taken one by one, RX path keeps going on others
+	rcu_read_lock();
+	win_table = rcu_dereference(net_priv->rx_reorder.win);
+	for (i = 0; (i < NET_RX_REORDER_WIN_NUM) && win_table; i++) {
+		win = &win_table[i];
+		spin_lock_bh(&win->lock);
+		if ((win->stored > 0) && (net_rx_reorder_expire(win, now, &list) == TRUE)) {
+			held = TRUE;
+		}
+		spin_unlock_bh(&win->lock);
+	}
+	rcu_read_unlock();
+
+	if (held == TRUE) {
+		(void)rs_k_timer_start(&net_priv->rx_reorder.timer, NET_RX_REORDER_TIMEOUT_US);
+	}
+
+	// timer is not NAPI context
+	(void)rs_net_rx_data_deliver(net_priv, &list, FALSE);
+}
+
+// Put MPDU in its window, or only mark its sequence number as received if skb is NULL
+static void net_rx_reorder_put(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_ext_hdr *ext_hdr,
+			       struct sk_buff *skb, struct sk_buff_head *list)
+{
+	struct rs_net_rx_reorder *win_table = NULL;
+	struct rs_net_rx_reorder *win = NULL;
+	bool held = FALSE;
+	u16 sn = RS_C_RX_SN(ext_hdr);
+	u8 slot = NET_RX_REORDER_SLOT(sn);
+
+	rcu_read_lock();
+
+	win_table = rcu_dereference(net_priv->rx_reorder.win);
+	if (win_table && (ext_hdr->sta_idx < RS_NET_PRIV_STA_TABLE_MAX) &&
+	    (ext_hdr->priority < RS_NET_RX_REORDER_TID_MAX)) {
+		win = &win_table[(ext_hdr->sta_idx * RS_NET_RX_REORDER_TID_MAX) + ext_hdr->priority];
+	}
+
+	if (!win) {
+		if (skb) {
+			__skb_queue_tail(list, skb);
+		}
+	} else {
+		spin_lock_bh(&win->lock);
+
+		if (win->started == FALSE) {
+			win->head_sn = sn;
+			win->started = TRUE;
+		}
+
+		if (ieee80211_sn_less(sn, win->head_sn)) {
+			// released before or given up, retransmission of it is late
+			win->stats.old_cnt++;
+			rs_net_skb_free((u8 *)skb);
+		} else if ((win->bitmap & BIT_ULL(slot)) != 0) {
+			win->stats.dup_cnt++;
+			rs_net_skb_free((u8 *)skb);
+		} else {
+			// MPDU beyond window moves window so it is its last one
+			if (!ieee80211_sn_less(sn, ieee80211_sn_add(win->head_sn, RS_NET_RX_REORDER_WIN))) {
+				net_rx_reorder_release_until(
+					win, ieee80211_sn_sub(sn, RS_NET_RX_REORDER_WIN - 1), list);
+			}
+
+			if (skb) {
+				RS_NET_RX_CB(skb)->rx_jiffies = jiffies;
+				win->stored++;
+			}
+			win->buf[slot] = skb;
+			win->bitmap |= BIT_ULL(slot);
+
+			net_rx_reorder_release_in_order(win, list);
+
+			if (skb && ((win->bitmap & BIT_ULL(slot)) != 0)) {
+				win->stats.held_cnt++;
+			}
+			held = (win->stored > 0) ? TRUE : FALSE;
+		}
+
+		spin_unlock_bh(&win->lock);
+	}
+
+	rcu_read_unlock();
+
+	if (held == TRUE) {
+		(void)rs_k_timer_start(&net_priv->rx_reorder.timer, NET_RX_REORDER_TIMEOUT_US);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+rs_ret rs_net_rx_reorder_init(struct rs_net_cfg80211_priv *net_priv)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_c_if *c_if = NULL;
+	struct rs_net_rx_reorder *win_table = NULL;
+	u16 i = 0;
+
+	c_if = rs_net_priv_get_c_if(net_priv);
+	if (c_if && c_if->core) {
+		RCU_INIT_POINTER(net_priv->rx_reorder.win, NULL);
+		ret = RS_SUCCESS;
+
+		// F/W reordering itself gives no sequence number
+		if ((c_if->core->rx.if_capa & RS_C_IF_CAPA_RX_REORDER) != 0) {
+			ret = rs_k_timer_create(&net_priv->rx_reorder.timer, net_rx_reorder_timer_handler,
+						net_priv);
+			if (ret == RS_SUCCESS) {
+				win_table = rs_k_calloc(NET_RX_REORDER_WIN_NUM *
+							sizeof(struct rs_net_rx_reorder));
+				if (win_table) {
+					for (i = 0; i < NET_RX_REORDER_WIN_NUM; i++) {
+						spin_lock_init(&win_table[i].lock);
+					}
+					rcu_assign_pointer(net_priv->rx_reorder.win, win_table);
+				} else {
+					(void)rs_k_timer_destroy(&net_priv->rx_reorder.timer);
+					ret = RS_MEMORY_FAIL;
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+rs_ret rs_net_rx_reorder_deinit(struct rs_net_cfg80211_priv *net_priv)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_net_rx_reorder *win_table = NULL;
+	u16 i = 0;
+
+	if (net_priv) {
+		if (rcu_access_pointer(net_priv->rx_reorder.win)) {
+			(void)rs_k_timer_destroy(&net_priv->rx_reorder.timer);
+
+			// RX path still in a window is waited for, later ones find none
+			win_table = rcu_replace_pointer(net_priv->rx_reorder.win, NULL, TRUE);
+			synchronize_net();
+
+			for (i = 0; i < NET_RX_REORDER_WIN_NUM; i++) {
+				net_rx_reorder_reset(&win_table[i]);
+			}
+			rs_k_free(win_table);
+		}
+
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+void rs_net_rx_reorder(struct rs_net_cfg80211_priv *net_priv, struct sk_buff *skb, struct sk_buff_head *list)
+{
+	net_rx_reorder_put(net_priv, &RS_NET_RX_CB(skb)->ext_hdr, skb, list);
+}
+
+void rs_net_rx_reorder_skip(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_ext_hdr *ext_hdr,
+			    struct sk_buff_head *list)
+{
+	net_rx_reorder_put(net_priv, ext_hdr, NULL, list);
+}
+
+void rs_net_rx_reorder_sta_reset(struct rs_net_cfg80211_priv *net_priv, u8 sta_idx)
+{
+	struct rs_net_rx_reorder *win_table = NULL;
+	struct rs_net_rx_reorder *win = NULL;
+	u8 tid = 0;
+
+	if (net_priv && (sta_idx < RS_NET_PRIV_STA_TABLE_MAX)) {
+		rcu_read_lock();
+		win_table = rcu_dereference(net_priv->rx_reorder.win);
+		for (tid = 0; (tid < RS_NET_RX_REORDER_TID_MAX) && win_table; tid++) {
+			win = &win_table[(sta_idx * RS_NET_RX_REORDER_TID_MAX) + tid];
+			spin_lock_bh(&win->lock);
+			net_rx_reorder_reset(win);
+			spin_unlock_bh(&win->lock);
+		}
+		rcu_read_unlock();
+	}
+}
+
+bool rs_net_rx_reorder_get_stats(struct rs_net_cfg80211_priv *net_priv,
+				 struct rs_net_rx_reorder_stats *stats)
+{
+	struct rs_net_rx_reorder *win_table = NULL;
+	bool on = FALSE;
+	u16 i = 0;
+
+	if (net_priv && stats) {
+		(void)rs_k_memset(stats, 0, sizeof(struct rs_net_rx_reorder_stats));
+
+		// counters are read without window locks, a count being added may be missed
+		rcu_read_lock();
+		win_table = rcu_dereference(net_priv->rx_reorder.win);
+		for (i = 0; (i < NET_RX_REORDER_WIN_NUM) && win_table; i++) {
+			stats->held_cnt += READ_ONCE(win_table[i].stats.held_cnt);
+			stats->dup_cnt += READ_ONCE(win_table[i].stats.dup_cnt);
+			stats->old_cnt += READ_ONCE(win_table[i].stats.old_cnt);
+			stats->timeout_cnt += READ_ONCE(win_table[i].stats.timeout_cnt);
+		}
+		on = (win_table) ? TRUE : FALSE;
+		rcu_read_unlock();
+	}
+
+	return on;
+}
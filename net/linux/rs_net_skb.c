@@ -10,6 +10,8 @@
 #include <linux/version.h>
 #include <linux/module.h>
 #include <net/cfg80211.h>
+#include <net/inet_ecn.h>
+#include <linux/bpf.h>
 
 #include "rs_type.h"
 #include "rs_k_mem.h"
@@ -22,6 +24,16 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
+// RX buffer keeps headroom in front and skb_shared_info behind, so sk_buff is built on it
+#ifdef CONFIG_RS_XDP
+// XDP program may grow frame head, and XDP frame is written in front of it
+#define NET_SKB_RX_HEADROOM (XDP_PACKET_HEADROOM)
+#else
+#define NET_SKB_RX_HEADROOM (NET_SKB_PAD)
+#endif
+#define NET_SKB_RX_BUF_SIZE(len) \
+	(SKB_DATA_ALIGN(NET_SKB_RX_HEADROOM + (len)) + SKB_DATA_ALIGN(sizeof(struct skb_shared_info)))
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
@@ -76,26 +88,76 @@ s32 rs_net_skb_get_data(u8 *skb, u8 **out_data)
 	return len;
 }
 
-u8 *rs_net_skb_add_tx_hdr(u8 *skb, u8 hdr_size)
+u32 rs_net_skb_get_hash(u8 *skb)
 {
-	rs_ret ret = RS_SUCCESS;
+	u32 hash = 0;
 	struct sk_buff *temp_skb = (struct sk_buff *)skb;
-	u8 *temp_data = NULL;
 
 	if (temp_skb) {
-		if (skb_headroom(temp_skb) < hdr_size) {
-			if (pskb_expand_head(temp_skb, hdr_size, 0, GFP_ATOMIC) != 0) {
-				ret = RS_FAIL;
-				RS_ERR("SKB resize failed[%d][%d]\n", skb_headroom(temp_skb), hdr_size);
-			}
+		hash = skb_get_hash(temp_skb);
+	}
+
+	return hash;
+}
+
+rs_ret rs_net_skb_set_ce(u8 *skb)
+{
+	rs_ret ret = RS_FAIL;
+	struct sk_buff *temp_skb = (struct sk_buff *)skb;
+
+	if (temp_skb) {
+		if (INET_ECN_set_ce(temp_skb) != 0) {
+			ret = RS_SUCCESS;
+		}
+	}
+
+	return ret;
+}
+
+u8 *rs_net_skb_rx_buf_alloc(u32 len)
+{
+	u8 *buf = NULL;
+
+	buf = netdev_alloc_frag(NET_SKB_RX_BUF_SIZE(len));
+	if (buf) {
+		buf += NET_SKB_RX_HEADROOM;
+	}
+
+	return buf;
+}
+
+void rs_net_skb_rx_buf_free(u8 *buf)
+{
+	if (buf) {
+		skb_free_frag(buf - NET_SKB_RX_HEADROOM);
+	}
+}
+
+u8 *rs_net_skb_rx_build(u8 *buf, u32 len, u32 offset, u32 data_len)
+{
+	struct sk_buff *temp_skb = NULL;
+
+	if (buf && (offset <= len) && (data_len <= len - offset)) {
+		temp_skb = build_skb(buf - NET_SKB_RX_HEADROOM, NET_SKB_RX_BUF_SIZE(len));
+		if (temp_skb) {
+			skb_reserve(temp_skb, NET_SKB_RX_HEADROOM + offset);
+			(void)skb_put(temp_skb, data_len);
 		}
+	}
+
+	return (u8 *)temp_skb;
+}
+
+u8 *rs_net_skb_rx_buf_head(u8 *buf, u32 len, u32 *size)
+{
+	u8 *head = NULL;
 
-		if (ret == RS_SUCCESS) {
-			temp_data = skb_push(temp_skb, hdr_size);
-		} else {
-			RS_ERR("SKB resize failed!!\n");
+	if (buf) {
+		head = buf - NET_SKB_RX_HEADROOM;
+		if (size) {
+			*size = NET_SKB_RX_BUF_SIZE(len);
 		}
 	}
 
-	return temp_data;
+	return head;
 }
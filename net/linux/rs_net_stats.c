@@ -6,14 +6,164 @@
 #include "rs_net_stats.h"
 #include "rs_net_ctrl.h"
 
+struct rs_net_pcpu_stats __percpu *rs_net_stats_pcpu_alloc(void)
+{
+	struct rs_net_pcpu_stats __percpu *pcpu = NULL;
+	int cpu = 0;
+
+	pcpu = alloc_percpu(struct rs_net_pcpu_stats);
+	if (pcpu) {
+		for_each_possible_cpu(cpu) {
+			u64_stats_init(&per_cpu_ptr(pcpu, cpu)->syncp);
+		}
+	}
+
+	return pcpu;
+}
+
+void rs_net_stats_pcpu_free(struct rs_net_pcpu_stats __percpu *pcpu)
+{
+	free_percpu(pcpu);
+}
+
+// Counters of new station start from zero, it has no traffic yet
+void rs_net_stats_pcpu_reset(struct rs_net_pcpu_stats __percpu *pcpu)
+{
+	struct rs_net_pcpu_stats *s = NULL;
+	int cpu = 0;
+
+	if (pcpu) {
+		for_each_possible_cpu(cpu) {
+			s = per_cpu_ptr(pcpu, cpu);
+			u64_stats_update_begin(&s->syncp);
+			s->rx_packets = 0;
+			s->rx_bytes = 0;
+			s->rx_multicast = 0;
+			s->rx_dropped = 0;
+			s->tx_packets = 0;
+			s->tx_bytes = 0;
+			s->tx_dropped = 0;
+			u64_stats_update_end(&s->syncp);
+		}
+	}
+}
+
+void rs_net_stats_rx(struct rs_net_pcpu_stats __percpu *pcpu, u32 len, bool mcast)
+{
+	struct rs_net_pcpu_stats *s = NULL;
+
+	if (pcpu) {
+		s = this_cpu_ptr(pcpu);
+		u64_stats_update_begin(&s->syncp);
+		s->rx_packets++;
+		s->rx_bytes += len;
+		if (mcast == TRUE) {
+			s->rx_multicast++;
+		}
+		u64_stats_update_end(&s->syncp);
+	}
+}
+
+void rs_net_stats_rx_drop(struct rs_net_pcpu_stats __percpu *pcpu)
+{
+	struct rs_net_pcpu_stats *s = NULL;
+
+	if (pcpu) {
+		s = this_cpu_ptr(pcpu);
+		u64_stats_update_begin(&s->syncp);
+		s->rx_dropped++;
+		u64_stats_update_end(&s->syncp);
+	}
+}
+
+void rs_net_stats_tx(struct rs_net_pcpu_stats __percpu *pcpu, u32 len, bool sent)
+{
+	struct rs_net_pcpu_stats *s = NULL;
+
+	if (pcpu) {
+		s = this_cpu_ptr(pcpu);
+		u64_stats_update_begin(&s->syncp);
+		if (sent == TRUE) {
+			s->tx_packets++;
+			s->tx_bytes += len;
+		} else {
+			s->tx_dropped++;
+		}
+		u64_stats_update_end(&s->syncp);
+	}
+}
+
+void rs_net_stats_pcpu_sum(struct rs_net_pcpu_stats __percpu *pcpu, struct rtnl_link_stats64 *stats)
+{
+	const struct rs_net_pcpu_stats *s = NULL;
+	struct rs_net_pcpu_stats tmp;
+	unsigned int start = 0;
+	int cpu = 0;
+
+	if (pcpu && stats) {
+		for_each_possible_cpu(cpu) {
+			s = per_cpu_ptr(pcpu, cpu);
+			// writer of other CPU may be in the middle of update on 32 bit
+			do {
+				start = u64_stats_fetch_begin(&s->syncp);
+				tmp.rx_packets = s->rx_packets;
+				tmp.rx_bytes = s->rx_bytes;
+				tmp.rx_multicast = s->rx_multicast;
+				tmp.rx_dropped = s->rx_dropped;
+				tmp.tx_packets = s->tx_packets;
+				tmp.tx_bytes = s->tx_bytes;
+				tmp.tx_dropped = s->tx_dropped;
+			} while (u64_stats_fetch_retry(&s->syncp, start));
+
+			stats->rx_packets += tmp.rx_packets;
+			stats->rx_bytes += tmp.rx_bytes;
+			stats->multicast += tmp.rx_multicast;
+			stats->rx_dropped += tmp.rx_dropped;
+			stats->tx_packets += tmp.tx_packets;
+			stats->tx_bytes += tmp.tx_bytes;
+			stats->tx_dropped += tmp.tx_dropped;
+		}
+	}
+}
+
+rs_ret rs_net_stats_sta_init(struct rs_net_cfg80211_priv *net_priv)
+{
+	rs_ret ret = RS_SUCCESS;
+	s32 i = 0;
+
+	for (i = 0; (i < RS_NET_PRIV_STA_TABLE_MAX) && (ret == RS_SUCCESS); i++) {
+		net_priv->sta_table[i].stats.pcpu = rs_net_stats_pcpu_alloc();
+		if (!net_priv->sta_table[i].stats.pcpu) {
+			ret = RS_MEMORY_FAIL;
+		}
+	}
+
+	if (ret != RS_SUCCESS) {
+		rs_net_stats_sta_deinit(net_priv);
+	}
+
+	return ret;
+}
+
+void rs_net_stats_sta_deinit(struct rs_net_cfg80211_priv *net_priv)
+{
+	s32 i = 0;
+
+	if (net_priv) {
+		for (i = 0; i < RS_NET_PRIV_STA_TABLE_MAX; i++) {
+			rs_net_stats_pcpu_free(net_priv->sta_table[i].stats.pcpu);
+			net_priv->sta_table[i].stats.pcpu = NULL;
+		}
+	}
+}
+
 #ifdef CONFIG_DBG_STATS
 
-void rs_net_rx_status_update(struct rs_net_cfg80211_priv *net_priv, struct rs_net_sta_stats *stats)
+void rs_net_rx_status_update(struct rs_net_cfg80211_priv *net_priv, struct rs_c_rx_ext_hdr *last_rx)
 {
 	struct rs_net_rx_stats *rx_stats = net_priv->dbg_stats.rx_stats;
-	struct rs_c_rx_ext_hdr *last_rx = &stats->last_rx_data_ext;
 
-	if (!(net_priv->dbg_stats.dbg_stats_enabled && rx_stats))
+	if (!(net_priv->dbg_stats.dbg_stats_enabled && rx_stats && last_rx))
 		return;
 
 	rx_stats->format_mode = last_rx->format_mod;
@@ -28,15 +28,123 @@
 ////////////////////////////////////////////////////////////////////////////////
 /// MACRO DEFINITION
 
+#define RS_NET_TX_CB(skb) ((struct rs_net_tx_cb *)((struct sk_buff *)(skb))->cb)
+
+// A-MSDU subframe header is DA, SA and length, LLC/SNAP and ethertype of frame follow it
+#define NET_TX_AMSDU_SNAP_LEN	 (sizeof(rfc1042_header))
+// frame grows by length and LLC/SNAP as it turns into subframe
+#define NET_TX_AMSDU_SUB_GROW	 (sizeof(__be16) + NET_TX_AMSDU_SNAP_LEN)
+#define NET_TX_AMSDU_ALIGN	 (4)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TYPE DEFINITION
 
+// skb control buffer of frame queued in core
+struct rs_net_tx_cb {
+	// IF TX header, written to bus as own fragment so frame needs no headroom
+	struct rs_c_tx_hdr hdr;
+	u32 bql_epoch;
+	// length accounted in BQL, frame grows as A-MSDU subframe
+	u32 bql_len;
+	bool bql;
+	// padding written in front of A-MSDU subframe
+	u8 amsdu_pad;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL VARIABLE
 
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+// zero bytes aligning A-MSDU subframes
+static u8 net_tx_amsdu_pad[NET_TX_AMSDU_ALIGN];
+
 ////////////////////////////////////////////////////////////////////////////////
 /// LOCAL FUNCTION
 
+// More frames of the same burst follow
+static bool rs_net_tx_xmit_more(struct sk_buff *skb)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 2, 0)
+	return netdev_xmit_more();
+#else
+	return skb->xmit_more;
+#endif
+}
+
+// Bring frame within fragment count bus takes, pages without kernel address are copied too
+static rs_ret rs_net_tx_data_sg_fit(struct sk_buff *skb)
+{
+	rs_ret ret = RS_SUCCESS;
+	bool linear = FALSE;
+	s32 i = 0;
+
+	// IF TX header and linear part take two fragments
+	if (skb_has_frag_list(skb) || (skb_shinfo(skb)->nr_frags > (RS_C_IF_FRAG_MAX - 2))) {
+		linear = TRUE;
+	}
+
+	for (i = 0; (i < skb_shinfo(skb)->nr_frags) && (linear == FALSE); i++) {
+		if (PageHighMem(skb_frag_page(&skb_shinfo(skb)->frags[i]))) {
+			linear = TRUE;
+		}
+	}
+
+	if ((linear == TRUE) && (skb_linearize(skb) != 0)) {
+		ret = RS_FAIL;
+	}
+
+	return ret;
+}
+
+// Fragments taken by data of skb, A-MSDU subframes and their padding included
+static u8 net_tx_data_frag_num(struct sk_buff *skb)
+{
+	struct sk_buff *sub_skb = NULL;
+	u32 frag_num = 0;
+
+	frag_num = ((skb_headlen(skb) > 0) ? 1 : 0) + skb_shinfo(skb)->nr_frags;
+	skb_walk_frags(skb, sub_skb) {
+		frag_num += ((RS_NET_TX_CB(sub_skb)->amsdu_pad > 0) ? 1 : 0) +
+			    ((skb_headlen(sub_skb) > 0) ? 1 : 0) + skb_shinfo(sub_skb)->nr_frags;
+	}
+
+	return (frag_num < U8_MAX) ? frag_num : U8_MAX;
+}
+
+// Turn frame into A-MSDU subframe in place, DA and SA move to make room for length and LLC/SNAP
+// so ethertype of frame stays right behind LLC/SNAP
+static rs_ret net_tx_amsdu_sub(struct sk_buff *skb)
+{
+	rs_ret ret = RS_FAIL;
+	u8 *sub_hdr = NULL;
+
+	if ((skb->len >= ETH_HLEN) && (skb_cow_head(skb, NET_TX_AMSDU_SUB_GROW) == 0)) {
+		sub_hdr = skb_push(skb, NET_TX_AMSDU_SUB_GROW);
+		memmove(sub_hdr, sub_hdr + NET_TX_AMSDU_SUB_GROW, ETH_ALEN * 2);
+		*(__be16 *)(sub_hdr + (ETH_ALEN * 2)) = htons(skb->len - ETH_HLEN);
+		(void)rs_k_memcpy(sub_hdr + ETH_HLEN, rfc1042_header, NET_TX_AMSDU_SNAP_LEN);
+
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+// Frame may go in A-MSDU, EAPOL stays single so F/W sees it as it is
+static bool net_tx_amsdu_allowed(struct sk_buff *skb)
+{
+	bool allowed = FALSE;
+
+	if ((skb->len >= ETH_HLEN) && (((struct ethhdr *)skb->data)->h_proto != htons(ETH_P_PAE)) &&
+	    !skb_has_frag_list(skb)) {
+		allowed = TRUE;
+	}
+
+	return allowed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// GLOBAL FUNCTION
 
@@ -70,13 +178,207 @@ rs_ret rs_net_if_tx_stop(struct rs_c_if *c_if, s8 vif_idx, bool stop)
 	return ret;
 }
 
+rs_ret rs_net_if_txq_stop(struct rs_c_if *c_if, s8 vif_idx, u16 txq_idx, bool stop)
+{
+	rs_ret ret = RS_FAIL;
+	struct rs_net_cfg80211_priv *net_priv = NULL;
+	struct net_device *ndev = NULL;
+	struct rs_net_vif_priv *vif_priv = NULL;
+
+	net_priv = rs_c_if_get_net_priv(c_if);
+	vif_priv = rs_net_priv_get_vif_priv(net_priv, vif_idx);
+	ndev = rs_vif_priv_get_ndev(vif_priv);
+	if (ndev && (txq_idx < ndev->real_num_tx_queues)) {
+		if (stop == TRUE) {
+			netif_stop_subqueue(ndev, txq_idx);
+		} else if (vif_priv->net_tx_stopped == FALSE) {
+			// whole interface stopped by link state, it is started from there
+			netif_wake_subqueue(ndev, txq_idx);
+		}
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+void rs_net_tx_data_queued(struct rs_c_if *c_if, s8 vif_idx, u8 *skb)
+{
+	struct sk_buff *temp_skb = (struct sk_buff *)skb;
+	struct rs_net_vif_priv *vif_priv = NULL;
+
+	// called from ndo_start_xmit, skb->dev is the sending netdev
+	if (temp_skb && temp_skb->dev) {
+		vif_priv = netdev_priv(temp_skb->dev);
+
+		RS_NET_TX_CB(temp_skb)->bql_epoch = vif_priv->bql_epoch;
+		RS_NET_TX_CB(temp_skb)->bql_len = temp_skb->len;
+		RS_NET_TX_CB(temp_skb)->bql = TRUE;
+		netdev_tx_sent_queue(netdev_get_tx_queue(temp_skb->dev, skb_get_queue_mapping(temp_skb)),
+				     temp_skb->len);
+	}
+}
+
+void rs_net_tx_data_done(struct rs_c_if *c_if, s8 vif_idx, u8 *skb)
+{
+	struct sk_buff *temp_skb = (struct sk_buff *)skb;
+	struct sk_buff *sub_skb = NULL;
+	struct rs_net_cfg80211_priv *net_priv = NULL;
+	struct net_device *ndev = NULL;
+	struct rs_net_vif_priv *vif_priv = NULL;
+	u32 pkts = 0;
+	u32 bytes = 0;
+
+	if (temp_skb && (RS_NET_TX_CB(temp_skb)->bql == TRUE)) {
+		net_priv = rs_c_if_get_net_priv(c_if);
+		vif_priv = rs_net_priv_get_vif_priv(net_priv, vif_idx);
+		ndev = rs_vif_priv_get_ndev(vif_priv);
+
+		// queues are reset on open, frames of an earlier open are not completed
+		if (ndev && (ndev == temp_skb->dev) && (vif_priv->up == TRUE) &&
+		    (RS_NET_TX_CB(temp_skb)->bql_epoch == vif_priv->bql_epoch)) {
+			pkts = 1;
+			bytes = RS_NET_TX_CB(temp_skb)->bql_len;
+
+			// A-MSDU subframes were queued as frames of the same netdev queue
+			skb_walk_frags(temp_skb, sub_skb) {
+				if (RS_NET_TX_CB(sub_skb)->bql == TRUE) {
+					pkts++;
+					bytes += RS_NET_TX_CB(sub_skb)->bql_len;
+				}
+			}
+
+			netdev_tx_completed_queue(netdev_get_tx_queue(ndev, skb_get_queue_mapping(temp_skb)),
+						  pkts, bytes);
+		}
+	}
+}
+
+struct rs_c_tx_hdr *rs_net_tx_data_hdr(u8 *skb)
+{
+	struct rs_c_tx_hdr *tx_hdr = NULL;
+
+	if (skb) {
+		tx_hdr = &RS_NET_TX_CB(skb)->hdr;
+	}
+
+	return tx_hdr;
+}
+
+u8 rs_net_tx_data_frag(u8 *skb, struct rs_c_if_frag *frag, u8 frag_max)
+{
+	struct sk_buff *temp_skb = (struct sk_buff *)skb;
+	struct sk_buff *sub_skb = NULL;
+	skb_frag_t *skb_frag = NULL;
+	u8 frag_num = 0;
+	s32 i = 0;
+
+	if (temp_skb && frag && (frag_max > net_tx_data_frag_num(temp_skb))) {
+		frag[frag_num].data = (u8 *)&RS_NET_TX_CB(temp_skb)->hdr;
+		frag[frag_num].len = RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, 0);
+		frag_num++;
+
+		// A-MSDU subframes follow first one in frag list
+		sub_skb = temp_skb;
+		while (sub_skb) {
+			if (RS_NET_TX_CB(sub_skb)->amsdu_pad > 0) {
+				frag[frag_num].data = net_tx_amsdu_pad;
+				frag[frag_num].len = RS_NET_TX_CB(sub_skb)->amsdu_pad;
+				frag_num++;
+			}
+
+			if (skb_headlen(sub_skb) > 0) {
+				frag[frag_num].data = sub_skb->data;
+				frag[frag_num].len = skb_headlen(sub_skb);
+				frag_num++;
+			}
+
+			for (i = 0; i < skb_shinfo(sub_skb)->nr_frags; i++) {
+				skb_frag = &skb_shinfo(sub_skb)->frags[i];
+				frag[frag_num].data = skb_frag_address(skb_frag);
+				frag[frag_num].len = skb_frag_size(skb_frag);
+				frag_num++;
+			}
+
+			sub_skb = (sub_skb == temp_skb) ? skb_shinfo(temp_skb)->frag_list : sub_skb->next;
+		}
+	}
+
+	return frag_num;
+}
+
+rs_ret rs_net_tx_data_amsdu(u8 *skb, u8 *sub_skb, u16 amsdu_len)
+{
+	rs_ret ret = RS_FAIL;
+	struct sk_buff *temp_skb = (struct sk_buff *)skb;
+	struct sk_buff *temp_sub_skb = (struct sk_buff *)sub_skb;
+	struct sk_buff *last_skb = NULL;
+	struct rs_c_tx_hdr *tx_hdr = NULL;
+	bool first = FALSE;
+	u32 len = 0;
+	u32 pad = 0;
+	u32 frag_num = 0;
+
+	if (temp_skb && temp_sub_skb && net_tx_amsdu_allowed(temp_sub_skb)) {
+		tx_hdr = &RS_NET_TX_CB(temp_skb)->hdr;
+		first = ((tx_hdr->ext_hdr.flags & RS_C_EXT_FLAGS_AMSDU) == 0) ? TRUE : FALSE;
+
+		len = tx_hdr->data_len + ((first == TRUE) ? NET_TX_AMSDU_SUB_GROW : 0);
+		pad = ALIGN(len, NET_TX_AMSDU_ALIGN) - len;
+		frag_num = 1 + net_tx_data_frag_num(temp_skb) + ((pad > 0) ? 1 : 0) +
+			   net_tx_data_frag_num(temp_sub_skb);
+
+		if (((len + pad + temp_sub_skb->len + NET_TX_AMSDU_SUB_GROW) <= amsdu_len) &&
+		    (frag_num <= RS_C_IF_FRAG_MAX) &&
+		    ((first == FALSE) || (net_tx_amsdu_allowed(temp_skb) == TRUE))) {
+			ret = RS_SUCCESS;
+		}
+	}
+
+	// first frame turns into subframe when second one joins
+	if ((ret == RS_SUCCESS) && (first == TRUE)) {
+		ret = net_tx_amsdu_sub(temp_skb);
+		if (ret == RS_SUCCESS) {
+			tx_hdr->ext_hdr.flags |= RS_C_EXT_FLAGS_AMSDU;
+			tx_hdr->data_len = temp_skb->len;
+		}
+	}
+
+	if (ret == RS_SUCCESS) {
+		ret = net_tx_amsdu_sub(temp_sub_skb);
+	}
+
+	if (ret == RS_SUCCESS) {
+		RS_NET_TX_CB(temp_sub_skb)->amsdu_pad = pad;
+
+		skb_walk_frags(temp_skb, last_skb) {
+			if (!last_skb->next) {
+				break;
+			}
+		}
+		temp_sub_skb->next = NULL;
+		if (last_skb) {
+			last_skb->next = temp_sub_skb;
+		} else {
+			skb_shinfo(temp_skb)->frag_list = temp_sub_skb;
+		}
+
+		temp_skb->len += temp_sub_skb->len;
+		temp_skb->data_len += temp_sub_skb->len;
+		temp_skb->truesize += temp_sub_skb->truesize;
+		tx_hdr->data_len += pad + temp_sub_skb->len;
+	}
+
+	return ret;
+}
+
 rs_ret rs_net_tx_mgmt(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, struct rs_net_sta_priv *sta,
 		      void *params, bool offchan, u64 *cookie)
 {
 	rs_ret ret = RS_FAIL;
 	struct cfg80211_mgmt_tx_params *temp_params = NULL;
 	struct sk_buff *temp_skb = NULL;
-	struct rs_c_tx_data *tx_data = NULL;
+	struct rs_c_tx_hdr *tx_hdr = NULL;
+	u8 *tx_frame = NULL;
 	struct ethhdr *temp_eth_hdr = NULL;
 	struct ethhdr *temp_eth_hdr2 = NULL;
 	s32 i = 0;
@@ -86,52 +388,52 @@ rs_ret rs_net_tx_mgmt(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, st
 	temp_params = (struct cfg80211_mgmt_tx_params *)params;
 
 	if (c_if && temp_params && temp_params->len > 0 && temp_params->buf) {
-		temp_skb = (struct sk_buff *)rs_net_skb_alloc(
-			RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, temp_params->len));
+		temp_skb = (struct sk_buff *)rs_net_skb_alloc(temp_params->len);
 		if (temp_skb) {
-			tx_len = rs_net_skb_get_data((u8 *)temp_skb, (u8 **)&tx_data);
+			tx_len = rs_net_skb_get_data((u8 *)temp_skb, &tx_frame);
+			tx_hdr = rs_net_tx_data_hdr((u8 *)temp_skb);
 		}
 
-		if (tx_data && tx_len == RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, temp_params->len)) {
+		if (tx_frame && tx_hdr && tx_len == temp_params->len) {
 			*cookie = (unsigned long)temp_skb;
 
 			temp_eth_hdr = eth_hdr(temp_skb);
-			temp_eth_hdr2 = (struct ethhdr *)(tx_data->data);
+			temp_eth_hdr2 = (struct ethhdr *)tx_frame;
 
-			(void)rs_k_memcpy(tx_data->data, temp_params->buf, temp_params->len);
+			(void)rs_k_memcpy(tx_frame, temp_params->buf, temp_params->len);
 
 			if (unlikely(temp_params->n_csa_offsets > 0) &&
 			    (RS_NET_WDEV_IF_TYPE(vif_priv) == NL80211_IFTYPE_AP) && (vif_priv->ap.csa)) {
 				for (i = 0; i < temp_params->n_csa_offsets; i++) {
-					tx_data->data[temp_params->csa_offsets[i]] = vif_priv->ap.csa->count;
+					tx_frame[temp_params->csa_offsets[i]] = vif_priv->ap.csa->count;
 				}
 			}
 
 			tx_buf_ac = IF_DATA_AC_POWER;
 
-			tx_data->cmd = RS_CMD_DATA_TX;
-			tx_data->ext_len = RS_C_TX_EXT_LEN;
-			tx_data->ext_hdr.buf_idx = tx_buf_ac;
-			tx_data->ext_hdr.tid = RS_NET_INVALID_TID;
-			tx_data->ext_hdr.vif_idx = vif_priv->vif_index;
-			tx_data->ext_hdr.sta_idx = (sta) ? sta->sta_idx : RS_NET_INVALID_STA_IDX;
+			tx_hdr->cmd = RS_CMD_DATA_TX;
+			tx_hdr->ext_len = RS_C_TX_EXT_LEN;
+			tx_hdr->ext_hdr.buf_idx = tx_buf_ac;
+			tx_hdr->ext_hdr.tid = RS_NET_INVALID_TID;
+			tx_hdr->ext_hdr.vif_idx = vif_priv->vif_index;
+			tx_hdr->ext_hdr.sta_idx = (sta) ? sta->sta_idx : RS_NET_INVALID_STA_IDX;
 
-			tx_data->ext_hdr.flags = RS_C_EXT_FLAGS_MGMT;
+			tx_hdr->ext_hdr.flags = RS_C_EXT_FLAGS_MGMT;
 
 			if (ieee80211_is_robust_mgmt_frame(temp_skb) != 0) {
-				tx_data->ext_hdr.flags |= RS_C_EXT_FLAGS_MGMT_ROBUST;
+				tx_hdr->ext_hdr.flags |= RS_C_EXT_FLAGS_MGMT_ROBUST;
 			}
 			if (temp_params->no_cck != 0) {
-				tx_data->ext_hdr.flags |= RS_C_EXT_FLAGS_MGMT_NO_CCK;
+				tx_hdr->ext_hdr.flags |= RS_C_EXT_FLAGS_MGMT_NO_CCK;
 			}
 
-			tx_data->ext_hdr.sn = 0;
-			tx_data->data_len = temp_params->len;
+			tx_hdr->ext_hdr.sn = 0;
+			tx_hdr->data_len = temp_params->len;
 
 			RS_DBG("P:net_tx_mgmt[%d]:vif[%d]:sta[%d]:skb_data src[" MAC_ADDRESS_STR
 			       " " MAC_ADDRESS_STR "],dest[" MAC_ADDRESS_STR " " MAC_ADDRESS_STR
 			       "],prot[0x%X 0x%X]\n",
-			       __LINE__, tx_data->ext_hdr.vif_idx, tx_data->ext_hdr.sta_idx,
+			       __LINE__, tx_hdr->ext_hdr.vif_idx, tx_hdr->ext_hdr.sta_idx,
 			       MAC_ADDR_ARRAY(temp_eth_hdr->h_source),
 			       MAC_ADDR_ARRAY(temp_eth_hdr2->h_source), MAC_ADDR_ARRAY(temp_eth_hdr->h_dest),
 			       MAC_ADDR_ARRAY(temp_eth_hdr2->h_dest), ntohs(temp_eth_hdr->h_proto),
@@ -140,8 +442,7 @@ rs_ret rs_net_tx_mgmt(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, st
 			ret = rs_c_tx_event_post(c_if, tx_buf_ac, vif_priv->vif_index, (u8 *)temp_skb);
 		} else {
 			rs_net_skb_free((u8 *)temp_skb);
-			RS_ERR("SKB alloc failed!![%d][%d]\n", tx_len,
-			       RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, temp_params->len));
+			RS_ERR("SKB alloc failed!![%d][%d]\n", tx_len, temp_params->len);
 		}
 	}
 
@@ -152,23 +453,26 @@ rs_ret rs_net_tx_mgmt(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, st
 rs_ret rs_net_tx_data(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, u8 *skb)
 {
 	rs_ret ret = RS_FAIL;
-	u8 hdr_size = RS_C_GET_DATA_SIZE(RS_C_TX_EXT_LEN, 0);
 	struct sk_buff *temp_skb = (struct sk_buff *)skb;
-	struct rs_c_tx_data *tx_data = NULL;
+	struct rs_c_tx_hdr *tx_hdr = NULL;
 	u8 prio = 0;
 	struct ethhdr *temp_eth_hdr = NULL;
 	u8 tx_buf_ac = IF_DATA_AC;
 	u16 sta_idx = 0;
+	bool more = FALSE;
 
 	if (c_if) {
+		// fresh control buffer, core reads IF TX header and BQL state of frame from it
+		memset(temp_skb->cb, 0, sizeof(temp_skb->cb));
+
 		sta_idx = skb_get_queue_mapping(temp_skb);
 		if (sta_idx == RS_NET_NDEV_INVALID_TXQ) {
 			RS_DBG("P:%s[%d]:invalid frame\n", __func__, __LINE__);
-		} else {
-			tx_data = (struct rs_c_tx_data *)rs_net_skb_add_tx_hdr((u8 *)temp_skb, hdr_size);
+		} else if (rs_net_tx_data_sg_fit(temp_skb) == RS_SUCCESS) {
+			tx_hdr = rs_net_tx_data_hdr((u8 *)temp_skb);
 		}
 
-		if (tx_data) {
+		if (tx_hdr) {
 			temp_eth_hdr = eth_hdr(temp_skb);
 
 			if ((temp_skb->priority == 0) ||
@@ -178,17 +482,24 @@ rs_ret rs_net_tx_data(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, u8
 				prio = temp_skb->priority;
 			}
 
-			tx_data->cmd = RS_CMD_DATA_TX;
-			tx_data->ext_len = RS_C_TX_EXT_LEN;
-			tx_data->ext_hdr.buf_idx = tx_buf_ac;
-			tx_data->ext_hdr.tid = prio;
-			tx_data->ext_hdr.vif_idx = vif_priv->vif_index;
-			tx_data->ext_hdr.sta_idx = sta_idx;
-			tx_data->ext_hdr.flags = 0;
-			tx_data->ext_hdr.sn = 0;
-			tx_data->data_len = (temp_skb->len - hdr_size);
-
-			ret = rs_c_tx_event_post(c_if, tx_buf_ac, vif_priv->vif_index, (u8 *)temp_skb);
+			tx_hdr->cmd = RS_CMD_DATA_TX;
+			tx_hdr->ext_len = RS_C_TX_EXT_LEN;
+			tx_hdr->ext_hdr.buf_idx = tx_buf_ac;
+			tx_hdr->ext_hdr.tid = prio;
+			tx_hdr->ext_hdr.vif_idx = vif_priv->vif_index;
+			tx_hdr->ext_hdr.sta_idx = sta_idx;
+			tx_hdr->ext_hdr.flags = 0;
+			tx_hdr->ext_hdr.sn = 0;
+			tx_hdr->data_len = temp_skb->len;
+
+			more = rs_net_tx_xmit_more(temp_skb);
+			ret = rs_c_tx_data_post(c_if, vif_priv->vif_index, (u8 *)temp_skb, more);
+
+			// stack sends no more frames to a stopped queue, burst ends here
+			if ((more == TRUE) &&
+			    netif_xmit_stopped(netdev_get_tx_queue(vif_priv->ndev, sta_idx))) {
+				(void)rs_c_tx_kick(c_if);
+			}
 
 			RS_DBG("P:net_tx[%d]:skb_data src[" MAC_ADDRESS_STR "],dest[" MAC_ADDRESS_STR
 			       "],prot[0x%X]\n",
@@ -205,3 +516,61 @@ rs_ret rs_net_tx_data(struct rs_c_if *c_if, struct rs_net_vif_priv *vif_priv, u8
 
 	return ret;
 }
+
+#ifdef CONFIG_RS_SELFTEST
+rs_ret rs_net_tx_data_amsdu_selftest(struct rs_c_if *c_if)
+{
+	rs_ret ret = RS_FAIL;
+	struct sk_buff *skb = NULL;
+	struct sk_buff *eth_skb = NULL;
+	struct sk_buff_head list;
+	struct ethhdr *eth = NULL;
+	u8 frame[ETH_HLEN + 64];
+	u32 i = 0;
+
+	for (i = 0; i < sizeof(frame); i++) {
+		frame[i] = (u8)i;
+	}
+	eth = (struct ethhdr *)frame;
+	eth_zero_addr(eth->h_dest);
+	eth_zero_addr(eth->h_source);
+	eth->h_dest[0] = 0x02;
+	eth->h_dest[ETH_ALEN - 1] = 0x01;
+	eth->h_source[0] = 0x02;
+	eth->h_source[ETH_ALEN - 1] = 0x02;
+	eth->h_proto = htons(ETH_P_IP);
+
+	__skb_queue_head_init(&list);
+
+	skb = dev_alloc_skb(NET_TX_AMSDU_SUB_GROW + sizeof(frame));
+	if (skb) {
+		skb_reserve(skb, NET_TX_AMSDU_SUB_GROW);
+		(void)skb_put_data(skb, frame, sizeof(frame));
+
+		if ((net_tx_amsdu_sub(skb) == RS_SUCCESS) &&
+		    (skb->len == (sizeof(frame) + NET_TX_AMSDU_SUB_GROW))) {
+			// split as RX path does, skb goes with it
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0)
+			ieee80211_amsdu_to_8023s(skb, &list, eth->h_dest, NL80211_IFTYPE_STATION, 0,
+						 NULL, NULL, 0);
+#else
+			ieee80211_amsdu_to_8023s(skb, &list, eth->h_dest, NL80211_IFTYPE_STATION, 0,
+						 NULL, NULL);
+#endif
+			skb = NULL;
+
+			eth_skb = __skb_dequeue(&list);
+			if (eth_skb && skb_queue_empty(&list) && (eth_skb->len == sizeof(frame)) &&
+			    (memcmp(eth_skb->data, frame, sizeof(frame)) == 0)) {
+				ret = RS_SUCCESS;
+			}
+		}
+	}
+
+	kfree_skb(skb);
+	kfree_skb(eth_skb);
+	__skb_queue_purge(&list);
+
+	return ret;
+}
+#endif
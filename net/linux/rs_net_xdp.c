@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+/**
+ * Copyright (C) [2022-2025] Renesas Electronics Corporation and/or its
+ * affiliates.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE
+
+#include <linux/version.h>
+#include <linux/module.h>
+#include <linux/filter.h>
+#include <linux/bpf_trace.h>
+#include <net/xdp.h>
+#include <net/cfg80211.h>
+
+#include "rs_type.h"
+#include "rs_c_dbg.h"
+#include "rs_c_data.h"
+
+#include "rs_net_cfg80211.h"
+#include "rs_net_priv.h"
+#include "rs_net_dev.h"
+#include "rs_net_skb.h"
+#include "rs_net_stats.h"
+#include "rs_net_rx_data.h"
+
+#include "rs_net_xdp.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// MACRO DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// TYPE DEFINITION
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL VARIABLE
+
+////////////////////////////////////////////////////////////////////////////////
+/// LOCAL FUNCTION
+
+// Build sk_buff on RX buffer of XDP_PASS frame, program may have moved its head and tail
+static struct sk_buff *net_xdp_build_skb(struct xdp_buff *xdp)
+{
+	struct sk_buff *skb = NULL;
+
+	skb = build_skb(xdp->data_hard_start, xdp->frame_sz);
+	if (skb) {
+		skb_reserve(skb, xdp->data - xdp->data_hard_start);
+		(void)skb_put(skb, xdp->data_end - xdp->data);
+		if (xdp->data_meta < xdp->data) {
+			skb_metadata_set(skb, xdp->data - xdp->data_meta);
+		}
+	}
+
+	return skb;
+}
+
+// TX path works on sk_buff, frame becomes one on its own buffer and goes through netdev queue of its station
+// Frame is taken on RS_SUCCESS even if TX path drops it
+static rs_ret net_xdp_xmit_frame(struct rs_net_vif_priv *vif_priv, struct xdp_frame *xdpf)
+{
+	rs_ret ret = RS_FAIL;
+	struct sk_buff *skb = NULL;
+
+	skb = xdp_build_skb_from_frame(xdpf, vif_priv->ndev);
+	if (skb) {
+		// eth_type_trans pulled Ethernet header, it is sent with frame
+		(void)skb_push(skb, ETH_HLEN);
+
+		vif_priv->xdp.xmit_cnt++;
+		if (net_xmit_eval(dev_queue_xmit(skb)) != 0) {
+			vif_priv->xdp.xmit_err_cnt++;
+		}
+
+		ret = RS_SUCCESS;
+	}
+
+	return ret;
+}
+
+static int net_xdp_setup(struct net_device *ndev, struct bpf_prog *prog)
+{
+	struct rs_net_vif_priv *vif_priv = netdev_priv(ndev);
+	struct bpf_prog *old_prog = NULL;
+
+	// RX path holds program under RCU, it is freed after readers are gone
+	old_prog = rcu_replace_pointer(vif_priv->xdp.prog, prog, lockdep_rtnl_is_held());
+	if (old_prog) {
+		bpf_prog_put(old_prog);
+	}
+
+	RS_INFO("%s XDP prog %s\n", ndev->name, prog ? "attached" : "detached");
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// GLOBAL FUNCTION
+
+rs_ret rs_net_xdp_open(struct rs_net_cfg80211_priv *net_priv, struct rs_net_vif_priv *vif_priv)
+{
+	rs_ret ret = RS_FAIL;
+	struct xdp_rxq_info *rxq = NULL;
+
+	if (net_priv && vif_priv && vif_priv->ndev) {
+		rxq = &vif_priv->xdp.rxq;
+		// frames of vif come through all RX NAPIs, first one stands for them
+		if (xdp_rxq_info_reg(rxq, vif_priv->ndev, 0, net_priv->rx_napi.q[0].napi.napi_id) == 0) {
+			// RX buffers are page fragments, frames leaving driver are freed as such
+			if (xdp_rxq_info_reg_mem_model(rxq, MEM_TYPE_PAGE_SHARED, NULL) == 0) {
+				ret = RS_SUCCESS;
+			} else {
+				xdp_rxq_info_unreg(rxq);
+			}
+		}
+
+		if (ret != RS_SUCCESS) {
+			RS_ERR("%s XDP RX queue info not registered\n", vif_priv->ndev->name);
+		}
+	}
+
+	return ret;
+}
+
+void rs_net_xdp_close(struct rs_net_vif_priv *vif_priv)
+{
+	if (vif_priv && xdp_rxq_info_is_reg(&vif_priv->xdp.rxq)) {
+		// RX path in NAPI poll may still use it
+		synchronize_net();
+		xdp_rxq_info_unreg(&vif_priv->xdp.rxq);
+	}
+}
+
+rs_ret rs_net_xdp_rx(struct rs_net_cfg80211_priv *net_priv, struct rs_net_vif_priv *vif_priv,
+		     struct rs_c_rx_data *rx_data, u8 **skb, bool *taken)
+{
+	rs_ret ret = RS_SUCCESS;
+	struct net_device *ndev = vif_priv->ndev;
+	struct bpf_prog *prog = NULL;
+	struct rs_net_rx_napi *rx_napi = NULL;
+	struct xdp_frame *xdpf = NULL;
+	struct xdp_buff xdp;
+	u8 *head = NULL;
+	u32 size = 0;
+	u32 act = XDP_PASS;
+
+	*skb = NULL;
+
+	rcu_read_lock();
+
+	prog = rcu_dereference(vif_priv->xdp.prog);
+	// A-MSDU becomes Ethernet frames only on sk_buff, it goes to network stack as it is
+	if (prog && (rx_data->ext_hdr.amsdu == 0) && xdp_rxq_info_is_reg(&vif_priv->xdp.rxq)) {
+		// program may write over IF header in headroom
+		rx_napi = rs_net_rx_napi_get(net_priv, &rx_data->ext_hdr);
+		head = rs_net_skb_rx_buf_head((u8 *)rx_data, RS_C_RX_BUF_SIZE, &size);
+		xdp_init_buff(&xdp, size, &vif_priv->xdp.rxq);
+		xdp_prepare_buff(&xdp, head, rx_data->data - head, rx_data->data_len, true);
+
+		act = bpf_prog_run_xdp(prog, &xdp);
+		switch (act) {
+		case XDP_PASS:
+			*skb = (u8 *)net_xdp_build_skb(&xdp);
+			if (*skb) {
+				*taken = TRUE;
+			} else {
+				rs_net_stats_rx_drop(vif_priv->pcpu_stats);
+				ret = RS_FAIL;
+			}
+			break;
+		case XDP_TX:
+			xdpf = xdp_convert_buff_to_frame(&xdp);
+			if (xdpf && (net_xdp_xmit_frame(vif_priv, xdpf) == RS_SUCCESS)) {
+				*taken = TRUE;
+			} else {
+				trace_xdp_exception(ndev, prog, act);
+			}
+			ret = RS_FAIL;
+			break;
+		case XDP_REDIRECT:
+			if (xdp_do_redirect(ndev, &xdp, prog) == 0) {
+				*taken = TRUE;
+				rx_napi->xdp_flush = TRUE;
+			} else {
+				trace_xdp_exception(ndev, prog, act);
+			}
+			ret = RS_FAIL;
+			break;
+		default:
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 17, 0)
+			bpf_warn_invalid_xdp_action(ndev, prog, act);
+#else
+			bpf_warn_invalid_xdp_action(act);
+#endif
+			act = XDP_ABORTED;
+			fallthrough;
+		case XDP_ABORTED:
+			trace_xdp_exception(ndev, prog, act);
+			fallthrough;
+		case XDP_DROP:
+			// RX buffer is not taken, it goes back to pool
+			ret = RS_FAIL;
+			break;
+		}
+
+		vif_priv->xdp.act_cnt[act]++;
+	}
+
+	rcu_read_unlock();
+
+	return ret;
+}
+
+void rs_net_xdp_flush(struct rs_net_rx_napi *rx_napi)
+{
+	if (rx_napi && (rx_napi->xdp_flush == TRUE)) {
+		rx_napi->xdp_flush = FALSE;
+		xdp_do_flush();
+	}
+}
+
+int rs_net_xdp_bpf(struct net_device *ndev, struct netdev_bpf *bpf)
+{
+	int ret = -EINVAL;
+
+	switch (bpf->command) {
+	case XDP_SETUP_PROG:
+		// frame always fits one RX buffer, so programs run on single buffer frames
+		ret = net_xdp_setup(ndev, bpf->prog);
+		break;
+	default:
+		break;
+	}
+
+	return ret;
+}
+
+int rs_net_xdp_xmit(struct net_device *ndev, int n, struct xdp_frame **frames, u32 flags)
+{
+	struct rs_net_vif_priv *vif_priv = netdev_priv(ndev);
+	int nxmit = 0;
+	int i = 0;
+
+	if ((flags & ~XDP_XMIT_FLAGS_MASK) != 0) {
+		nxmit = -EINVAL;
+	} else if (rs_net_vif_is_up(vif_priv) != RS_SUCCESS) {
+		nxmit = -ENETDOWN;
+	} else {
+		// frames are queued at once, XDP_XMIT_FLUSH has nothing to do
+		for (i = 0; i < n; i++) {
+			// frames not taken are returned by caller
+			if (net_xdp_xmit_frame(vif_priv, frames[i]) != RS_SUCCESS) {
+				break;
+			}
+			nxmit++;
+		}
+	}
+
+	return nxmit;
+}